@@ -0,0 +1,37 @@
+/** @file
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __BL_HOB_LIB_H__
+#define __BL_HOB_LIB_H__
+
+#include <Library/HobLib.h>
+
+/**
+  Build a lookup index for a HOB list.
+
+  Once built, GetNextHob (), GetNextGuidHob () and the functions based on
+  them look up HOBs in this list through the index instead of walking the
+  list. The index is rebuilt automatically when HOBs are appended to the list.
+  Only one HOB list can be indexed at a time, building an index for another
+  list replaces the previous one.
+
+  This function must not be called from execute-in-place stages.
+
+  @param[in]  HobList       The HOB list to index.
+
+  @retval EFI_SUCCESS            The index was built.
+  @retval EFI_INVALID_PARAMETER  HobList is NULL.
+  @retval EFI_OUT_OF_RESOURCES   No enough memory for the index.
+
+**/
+EFI_STATUS
+EFIAPI
+BuildHobIndex (
+  IN CONST VOID             *HobList
+  );
+
+#endif
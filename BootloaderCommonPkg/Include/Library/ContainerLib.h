@@ -56,6 +56,7 @@ typedef struct {
   UINT32           HeaderCache;
   UINT32           HeaderSize;
   UINT32           Base;
+  UINT32           Sequence;
 } CONTAINER_ENTRY;
 
 typedef struct {
@@ -117,6 +118,43 @@ LoadComponentWithCallback (
   IN     LOAD_COMPONENT_CALLBACK  LoadComponentCallback
   );
 
+/**
+  Load a component from a memory copy prefetched from its location and call
+  callback function at predefined point.
+
+  The copy is only used if the component is still located at CopySrc and
+  fits in the copy. Otherwise the component is loaded from its location as
+  LoadComponentWithCallback() does.
+
+  @param[in]     ContainerSig    Container signature or component type.
+  @param[in]     ComponentName   Component name.
+  @param[in]     CopySrc         Component base the memory copy was taken from.
+  @param[in]     CopyBuf         Memory copy of the component.
+  @param[in]     CopyLen         Size of the memory copy in bytes.
+  @param[in,out] Buffer          Pointer to receive component base.
+  @param[in,out] Length          Pointer to receive component size.
+  @param[in]     CallbackFunc    Callback function pointer.
+
+  @retval EFI_UNSUPPORTED          Unsupported AuthType.
+  @retval EFI_NOT_FOUND            Cannot locate component.
+  @retval EFI_BUFFER_TOO_SMALL     Specified buffer size is too small.
+  @retval EFI_SECURITY_VIOLATION   Authentication failed.
+  @retval EFI_SUCCESS              Authentication succeeded.
+
+**/
+EFI_STATUS
+EFIAPI
+LoadPrefetchedComponent (
+  IN     UINT32                   ContainerSig,
+  IN     UINT32                   ComponentName,
+  IN     VOID                    *CopySrc,
+  IN     VOID                    *CopyBuf,
+  IN     UINT32                   CopyLen,
+  IN OUT VOID                   **Buffer,
+  IN OUT UINT32                  *Length,
+  IN     LOAD_COMPONENT_CALLBACK  LoadComponentCallback
+  );
+
 /**
   Locate a component region information from a container or flash map.
 
@@ -243,6 +281,8 @@ RegisterContainer (
   This function unregisters a container with given signature.
 
   @param[in]  Signature      Container signature.
+                             0xFFFFFFFF unregisters the most recently
+                             registered container.
 
   @retval EFI_NOT_READY          Not ready for unregister yet.
   @retval EFI_NOT_FOUND          Not container available for unregisteration.
@@ -15,6 +15,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Guid/SystemResourceTable.h>
 #include <Guid/BootLoaderVersionGuid.h>
 #include <Service/SpiFlashService.h>
+#include <Library/CryptoLib.h>
 
 #define CMOS_ADDREG             0x70
 #define CMOS_DATAREG            0x71
@@ -57,6 +58,14 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define FW_UPDATE_STATUS_SIGNATURE SIGNATURE_32 ('F', 'W', 'U', 'S')
 #define FW_UPDATE_STATUS_VERSION   0x1
 
+//
+// The update journal follows the status and component structures in the
+// first page of the reserved region. It is cleared together with them.
+//
+#define FW_UPDATE_JOURNAL_OFFSET   0x200
+#define FW_UPDATE_JOURNAL_SIZE     (EFI_PAGE_SIZE - FW_UPDATE_JOURNAL_OFFSET)
+#define FW_UPDATE_JOURNAL_FREE     0xFF
+
 ///
 /// "FWST"  Firmware Update status data Table
 /// This table contains pointer to the ESRT (EFI System Resource Table)structure
@@ -117,6 +126,16 @@ typedef struct {
   UINT8                 Reserved[3];
 } FW_UPDATE_COMP_STATUS;
 
+//
+// Firmware update journal entry
+// One entry is appended for every block that has been written and
+// verified, so that a resumed update can skip it.
+//
+typedef struct {
+  UINT32                Address;
+  UINT8                 Hash[SHA256_DIGEST_SIZE];
+} FW_UPDATE_JOURNAL_ENTRY;
+
 typedef union _FIRMWARE_UPDATE_POLICY {
   UINT32 Data;
   struct {
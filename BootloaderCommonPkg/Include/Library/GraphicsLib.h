@@ -70,6 +70,11 @@ typedef struct {
   UINTN                         CursorY;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL ForegroundColor;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL BackgroundColor;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL *GlyphTileBuf;
+  UINT8                         *GlyphTileValid;
+  UINTN                         GlyphCount;
+  UINTN                         DirtyTop;
+  UINTN                         DirtyBottom;
 } FRAME_BUFFER_CONSOLE;
 
 
@@ -193,6 +198,27 @@ InitFrameBufferConsole (
   IN     UINTN                 OffY
   );
 
+/**
+  Invalidate the console cells covering an area of the frame buffer.
+
+  This must be called whenever pixels are drawn outside of the console so
+  that the console does not assume those cells still show their text.
+
+  @param[in] OffX                X offset of the area (in pixels)
+  @param[in] OffY                Y offset of the area (in pixels)
+  @param[in] Width               Width of the area (in pixels)
+  @param[in] Height              Height of the area (in pixels)
+
+**/
+VOID
+EFIAPI
+FrameBufferConsoleInvalidate (
+  IN UINTN                OffX,
+  IN UINTN                OffY,
+  IN UINTN                Width,
+  IN UINTN                Height
+  );
+
 /**
   Scroll the console area of the screen up.
 
@@ -142,6 +142,11 @@ typedef struct {
   /// This field is used to store the distance of two neighbouring VAR_ADDED type variables.
   /// The meaning of the field is implement-dependent.
   UINT16          Index[UEFI_VARIABLE_INDEX_TABLE_VOLUME];
+  ///
+  /// Hash of the name and vendor GUID of each indexed variable, so that lookups
+  /// only need to touch NV storage for likely matches. 0 means not available.
+  ///
+  UINT16          NameHash[UEFI_VARIABLE_INDEX_TABLE_VOLUME];
 } UEFI_VARIABLE_INDEX_TABLE;
 
 //
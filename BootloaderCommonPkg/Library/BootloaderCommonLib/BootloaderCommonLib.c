@@ -262,6 +262,12 @@ GetServiceBySignature (
   ServiceList = (SERVICES_LIST *)GetServiceListPtr ();
   for (Index = 0; Index < ServiceList->Count; Index++) {
     ServiceHeader = ServiceList->Header[Index];
+    if (ServiceHeader == NULL) {
+      //
+      // Services are registered into the first free slot, stop at the end of the list
+      //
+      break;
+    }
     if (ServiceHeader->Signature == Signature) {
       return ServiceHeader;
     }
@@ -23,6 +23,51 @@
 
 #define  IS_FLASH_ADDRESS(x)   (((UINT32)(UINTN)(x)) >= 0xF0000000)
 
+/**
+  Search the container list for a container signature.
+
+  The container list entries are kept sorted by signature so that
+  a binary search can be used.
+
+  @param[in]  ContainerList       The container list to search.
+  @param[in]  Signature           The signature for the container to search.
+  @param[out] Position            Index of the matched entry, or the index where
+                                  an entry with this signature should be inserted.
+
+  @retval TRUE                    The container was found.
+  @retval FALSE                   The container was not found.
+
+**/
+STATIC
+BOOLEAN
+SearchContainerList (
+  IN  CONTAINER_LIST  *ContainerList,
+  IN  UINT32           Signature,
+  OUT UINT32          *Position
+  )
+{
+  UINT32                Low;
+  UINT32                High;
+  UINT32                Mid;
+
+  Low  = 0;
+  High = ContainerList->Count;
+  while (Low < High) {
+    Mid = Low + ((High - Low) >> 1);
+    if (ContainerList->Entry[Mid].Signature == Signature) {
+      *Position = Mid;
+      return TRUE;
+    } else if (ContainerList->Entry[Mid].Signature < Signature) {
+      Low  = Mid + 1;
+    } else {
+      High = Mid;
+    }
+  }
+
+  *Position = Low;
+  return FALSE;
+}
+
 /**
   Get the container pointer by the container signature
 
@@ -40,16 +85,10 @@ GetContainerBySignature (
 {
   UINT32                Index;
   CONTAINER_LIST       *ContainerList;
-  CONTAINER_ENTRY      *ContainerEntry;
 
   ContainerList = (CONTAINER_LIST *)GetContainerListPtr ();
-  if (ContainerList != NULL) {
-    for (Index = 0; Index < ContainerList->Count; Index++) {
-      ContainerEntry = (CONTAINER_ENTRY *)&ContainerList->Entry[Index];
-      if (ContainerEntry->Signature == Signature) {
-        return ContainerEntry;
-      }
-    }
+  if ((ContainerList != NULL) && SearchContainerList (ContainerList, Signature, &Index)) {
+    return &ContainerList->Entry[Index];
   }
 
   return NULL;
@@ -111,6 +150,8 @@ RegisterContainerInternal (
   CONTAINER_HDR        *ContainerHdr;
   CONTAINER_ENTRY      *ContainerEntry;
   UINT32                Index;
+  UINT32                Loop;
+  UINT32                Sequence;
   VOID                 *Buffer;
   UINT32                MaxHdrSize;
 
@@ -120,13 +161,11 @@ RegisterContainerInternal (
   }
 
   ContainerHdr   = (CONTAINER_HDR *)(UINTN)ContainerBase;
-  ContainerEntry = GetContainerBySignature (ContainerHdr->Signature);
-  if (ContainerEntry != NULL) {
+  if (SearchContainerList (ContainerList, ContainerHdr->Signature, &Index)) {
     return EFI_UNSUPPORTED;
   }
 
-  Index = ContainerList->Count;
-  if (Index >= PcdGet32 (PcdContainerMaxNumber)) {
+  if (ContainerList->Count >= PcdGet32 (PcdContainerMaxNumber)) {
     return EFI_BUFFER_TOO_SMALL;
   }
 
@@ -140,10 +179,24 @@ RegisterContainerInternal (
     return  EFI_OUT_OF_RESOURCES;
   }
 
+  //
+  // Keep the list sorted by signature. The registration order is tracked
+  // separately so that the last registered container can be unregistered.
+  //
+  Sequence = 0;
+  for (Loop = 0; Loop < ContainerList->Count; Loop++) {
+    if (ContainerList->Entry[Loop].Sequence >= Sequence) {
+      Sequence = ContainerList->Entry[Loop].Sequence + 1;
+    }
+  }
+
+  ContainerEntry = &ContainerList->Entry[Index];
+  CopyMem (ContainerEntry + 1, ContainerEntry, (ContainerList->Count - Index) * sizeof (CONTAINER_ENTRY));
   ContainerList->Entry[Index].Signature   = ContainerHdr->Signature;
   ContainerList->Entry[Index].HeaderCache = (UINT32)(UINTN)Buffer;
   ContainerList->Entry[Index].HeaderSize  = MaxHdrSize ;
   ContainerList->Entry[Index].Base        = ContainerBase;
+  ContainerList->Entry[Index].Sequence    = Sequence;
   CopyMem (Buffer, (VOID *)(UINTN)ContainerBase, MaxHdrSize);
   ContainerList->Count++;
 
@@ -155,6 +208,8 @@ RegisterContainerInternal (
   This function unregisters a container with given signature.
 
   @param[in]  Signature      Container signature.
+                             0xFFFFFFFF unregisters the most recently
+                             registered container.
 
   @retval EFI_NOT_READY          Not ready for unregister yet.
   @retval EFI_NOT_FOUND          Not container available for unregisteration.
@@ -171,6 +226,7 @@ UnregisterContainer (
   CONTAINER_ENTRY      *ContainerEntry;
   UINT32                Index;
   UINT32                LastIndex;
+  UINT32                Loop;
 
   ContainerList = (CONTAINER_LIST *)GetContainerListPtr ();
   if (ContainerList == NULL) {
@@ -184,19 +240,20 @@ UnregisterContainer (
 
   LastIndex = ContainerList->Count - 1;
   if (Signature == 0xFFFFFFFF) {
-    Index = LastIndex;
-  } else {
-    for (Index = 0; Index < ContainerList->Count; Index++) {
-      ContainerEntry = (CONTAINER_ENTRY *)&ContainerList->Entry[Index];
-      if (ContainerEntry->Signature == Signature) {
-        break;
+    Index = 0;
+    for (Loop = 1; Loop < ContainerList->Count; Loop++) {
+      if (ContainerList->Entry[Loop].Sequence > ContainerList->Entry[Index].Sequence) {
+        Index = Loop;
       }
     }
+  } else if (!SearchContainerList (ContainerList, Signature, &Index)) {
+    Index = ContainerList->Count;
   }
 
   if (Index < ContainerList->Count) {
     FreePool ((VOID *)(UINTN)ContainerList->Entry[Index].HeaderCache);
-    ContainerList->Entry[Index] = ContainerList->Entry[LastIndex];
+    ContainerEntry = &ContainerList->Entry[Index];
+    CopyMem (ContainerEntry, ContainerEntry + 1, (LastIndex - Index) * sizeof (CONTAINER_ENTRY));
     ContainerList->Count--;
     Status = EFI_SUCCESS;
   }
@@ -662,7 +719,7 @@ LocateComponent (
   if (ContainerSig < COMP_TYPE_INVALID) {
     // It is a component type, so get the info from flash map
     Status = GetComponentInfo (ComponentName, (UINT32 *)Buffer, Length);
-    return EFI_NOT_FOUND;
+    return Status;
   }
 
   Status = LocateComponentEntry (ContainerSig, ComponentName, &ContainerEntry, &CompEntry);
@@ -689,11 +746,17 @@ LocateComponent (
   Load a component from a container or flahs map to memory and call callback
   function at predefined point.
 
+  If CopyBuf is provided and the component is located at CopySrc, the memory
+  copy is authenticated and decompressed instead of the original location.
+
   @param[in]     ContainerSig    Container signature or component type.
   @param[in]     ComponentName   Component name.
   @param[in,out] Buffer          Pointer to receive component base.
   @param[in,out] Length          Pointer to receive component size.
   @param[in,out] LoadComponentCallback  Callback function pointer.
+  @param[in]     CopySrc         Component base the memory copy was taken from.
+  @param[in]     CopyBuf         Memory copy of the component, or NULL.
+  @param[in]     CopyLen         Size of the memory copy in bytes.
 
   @retval EFI_UNSUPPORTED          Unsupported AuthType.
   @retval EFI_NOT_FOUND            Cannot locate component.
@@ -702,14 +765,17 @@ LocateComponent (
   @retval EFI_SUCCESS              Authentication succeeded.
 
 **/
+STATIC
 EFI_STATUS
-EFIAPI
-LoadComponentWithCallback (
+LoadComponentInternal (
   IN     UINT32                   ContainerSig,
   IN     UINT32                   ComponentName,
   IN OUT VOID                   **Buffer,
   IN OUT UINT32                  *Length,
-  IN     LOAD_COMPONENT_CALLBACK  LoadComponentCallback
+  IN     LOAD_COMPONENT_CALLBACK  LoadComponentCallback,
+  IN     VOID                    *CopySrc,
+  IN     VOID                    *CopyBuf,
+  IN     UINT32                   CopyLen
   )
 {
   EFI_STATUS                Status;
@@ -795,6 +861,11 @@ LoadComponentWithCallback (
     CompLen   = CompEntry->Size;
   }
 
+  // Use the memory copy only if it was taken from the same location
+  if ((CopyBuf != NULL) && (CompData == CopySrc) && (CompLen <= CopyLen)) {
+    CompData = CopyBuf;
+  }
+
   if (LoadComponentCallback != NULL) {
     LoadComponentCallback (PROGESS_ID_LOCATE, NULL);
   }
@@ -918,6 +989,79 @@ LoadComponentWithCallback (
   return Status;
 }
 
+/**
+  Load a component from a container or flahs map to memory and call callback
+  function at predefined point.
+
+  @param[in]     ContainerSig    Container signature or component type.
+  @param[in]     ComponentName   Component name.
+  @param[in,out] Buffer          Pointer to receive component base.
+  @param[in,out] Length          Pointer to receive component size.
+  @param[in,out] LoadComponentCallback  Callback function pointer.
+
+  @retval EFI_UNSUPPORTED          Unsupported AuthType.
+  @retval EFI_NOT_FOUND            Cannot locate component.
+  @retval EFI_BUFFER_TOO_SMALL     Specified buffer size is too small.
+  @retval EFI_SECURITY_VIOLATION   Authentication failed.
+  @retval EFI_SUCCESS              Authentication succeeded.
+
+**/
+EFI_STATUS
+EFIAPI
+LoadComponentWithCallback (
+  IN     UINT32                   ContainerSig,
+  IN     UINT32                   ComponentName,
+  IN OUT VOID                   **Buffer,
+  IN OUT UINT32                  *Length,
+  IN     LOAD_COMPONENT_CALLBACK  LoadComponentCallback
+  )
+{
+  return LoadComponentInternal (ContainerSig, ComponentName, Buffer, Length,
+                                LoadComponentCallback, NULL, NULL, 0);
+}
+
+/**
+  Load a component from a memory copy prefetched from its location and call
+  callback function at predefined point.
+
+  The copy is only used if the component is still located at CopySrc and
+  fits in the copy. Otherwise the component is loaded from its location as
+  LoadComponentWithCallback() does. The copy is always authenticated before
+  it is decompressed.
+
+  @param[in]     ContainerSig    Container signature or component type.
+  @param[in]     ComponentName   Component name.
+  @param[in]     CopySrc         Component base the memory copy was taken from.
+  @param[in]     CopyBuf         Memory copy of the component.
+  @param[in]     CopyLen         Size of the memory copy in bytes.
+  @param[in,out] Buffer          Pointer to receive component base.
+  @param[in,out] Length          Pointer to receive component size.
+  @param[in]     LoadComponentCallback  Callback function pointer.
+
+  @retval EFI_UNSUPPORTED          Unsupported AuthType.
+  @retval EFI_NOT_FOUND            Cannot locate component.
+  @retval EFI_BUFFER_TOO_SMALL     Specified buffer size is too small.
+  @retval EFI_SECURITY_VIOLATION   Authentication failed.
+  @retval EFI_SUCCESS              Authentication succeeded.
+
+**/
+EFI_STATUS
+EFIAPI
+LoadPrefetchedComponent (
+  IN     UINT32                   ContainerSig,
+  IN     UINT32                   ComponentName,
+  IN     VOID                    *CopySrc,
+  IN     VOID                    *CopyBuf,
+  IN     UINT32                   CopyLen,
+  IN OUT VOID                   **Buffer,
+  IN OUT UINT32                  *Length,
+  IN     LOAD_COMPONENT_CALLBACK  LoadComponentCallback
+  )
+{
+  return LoadComponentInternal (ContainerSig, ComponentName, Buffer, Length,
+                                LoadComponentCallback, CopySrc, CopyBuf, CopyLen);
+}
+
 
 /**
   Load a component from a container or flash map to memory.
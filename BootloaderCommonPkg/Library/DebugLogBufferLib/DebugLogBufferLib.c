@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <PiPei.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/SynchronizationLib.h>
 #include <Library/BootloaderCommonLib.h>
 #include <Library/DebugLogBufferLib.h>
 #include <Guid/LoaderPlatformDataGuid.h>
@@ -40,6 +41,10 @@ DebugLogBufferWrite (
 {
   DEBUG_LOG_BUFFER_HEADER  *LogBufHdr;
   UINTN                     RemainingBytes;
+  UINTN                     MaxBytes;
+  UINT32                    OldLength;
+  UINT32                    NewLength;
+  UINT32                    Offset;
 
   // This function will be called by DEBUG or ASSERT macro.
   // So please DON'T use DEBUG/ASSERT macro inside this function,
@@ -53,23 +58,38 @@ DebugLogBufferWrite (
     return 0;
   }
 
-  //
-  // Something wrong in Debug Log Buffer.
-  // Reset buffer index and continue to record logs.
-  //
-  if (LogBufHdr->UsedLength > LogBufHdr->TotalLength) {
-    LogBufHdr->UsedLength = LogBufHdr->HeaderLength;
-  }
-
-  RemainingBytes = 0;
-  if (LogBufHdr->UsedLength + NumberOfBytes > LogBufHdr->TotalLength) {
-    RemainingBytes = LogBufHdr->UsedLength + NumberOfBytes - LogBufHdr->TotalLength;
-    NumberOfBytes  = LogBufHdr->TotalLength - LogBufHdr->UsedLength;
+  MaxBytes = LogBufHdr->TotalLength - LogBufHdr->HeaderLength;
+  if (NumberOfBytes > MaxBytes) {
+    NumberOfBytes = MaxBytes;
   }
 
+  //
+  // Reserve the range for this message by advancing UsedLength atomically,
+  // so that messages written concurrently from APs never overlap.
+  //
+  do {
+    OldLength = LogBufHdr->UsedLength;
+    Offset    = OldLength;
+
+    //
+    // Something wrong in Debug Log Buffer.
+    // Reset buffer index and continue to record logs.
+    //
+    if (Offset > LogBufHdr->TotalLength) {
+      Offset = LogBufHdr->HeaderLength;
+    }
+
+    RemainingBytes = 0;
+    NewLength      = Offset + (UINT32)NumberOfBytes;
+    if (NewLength > LogBufHdr->TotalLength) {
+      RemainingBytes = NewLength - LogBufHdr->TotalLength;
+      NewLength      = LogBufHdr->HeaderLength + (UINT32)RemainingBytes;
+    }
+  } while (InterlockedCompareExchange32 (&LogBufHdr->UsedLength, OldLength, NewLength) != OldLength);
+
+  NumberOfBytes -= RemainingBytes;
   if (NumberOfBytes > 0) {
-    CopyMem (&LogBufHdr->Buffer[LogBufHdr->UsedLength - LogBufHdr->HeaderLength], Buffer, NumberOfBytes);
-    LogBufHdr->UsedLength += (UINT32)NumberOfBytes;
+    CopyMem (&LogBufHdr->Buffer[Offset - LogBufHdr->HeaderLength], Buffer, NumberOfBytes);
   }
 
   //
@@ -77,7 +97,6 @@ DebugLogBufferWrite (
   //
   if (RemainingBytes > 0) {
     CopyMem (&LogBufHdr->Buffer[0], Buffer + NumberOfBytes, RemainingBytes);
-    LogBufHdr->UsedLength = LogBufHdr->HeaderLength + (UINT32)RemainingBytes;
     LogBufHdr->Attribute |= DEBUG_LOG_BUFFER_ATTRIBUTE_FULL;
   }
 
@@ -308,6 +308,8 @@ DisplayBmpToFrameBuffer (
 End:
   if (IsAllocated) {
     FreePool (BltLineBuf);
+    // Rows were drawn bottom-up, starting from line OffY + PixelHeight
+    FrameBufferConsoleInvalidate (OffX, OffY, PixelWidth, PixelHeight + 1);
   }
 
   return Status;
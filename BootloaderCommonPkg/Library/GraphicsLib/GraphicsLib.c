@@ -12,6 +12,13 @@
 
 #define  ANSI_ESCAPE_SEQ_CLEAR_SCREEN    (UINT8 *)"\x1b[2J"
 
+//
+// TextDisplayBuf value for a cell whose pixels were overwritten outside of
+// the console. A newline only moves the cursor, so it never appears in
+// TextSwapBuf and the cell is always redrawn on the next flush of its row.
+//
+#define  TEXT_CELL_STALE                 '\n'
+
 CONST EFI_GRAPHICS_OUTPUT_BLT_PIXEL mColors[16] = {
   //
   // B     G     R
@@ -87,6 +94,101 @@ BltToFrameBuffer (
   return EFI_SUCCESS;
 }
 
+/**
+  Map an ASCII character to its index in the narrow glyph table.
+
+  @param[in] Glyph               ASCII character
+
+  @retval                        Index into gUsStdNarrowGlyphData
+
+**/
+STATIC
+UINTN
+GetGlyphIndex (
+  IN CHAR8                         Glyph
+  )
+{
+  UINTN                            Code;
+  UINTN                            Base;
+
+  // Glyph table maps to ASCII characters, index the table with the character
+  Code = (UINTN)(Glyph & 0xFF);
+  Base = 0xAF;
+  if ((Code >= Base) && (Code <= 0xF2)) {
+    Code = (0x80 - 0x20) + (Code - Base);
+  } else if ((Code >= 0x20) && (Code <= 0x7F)) {
+    Code = Code - 0x20;
+  } else {
+    Code = 0;
+  }
+
+  if (Code >= mNarrowFontSize / sizeof (EFI_NARROW_GLYPH)) {
+    Code = 0;
+  }
+
+  return Code;
+}
+
+/**
+  Expand a glyph bitmap into a pixel tile.
+
+  @param[in]  Code               Index into the narrow glyph table
+  @param[in]  ForegroundColor    Foreground color to use
+  @param[in]  BackgroundColor    Background color to use
+  @param[out] GopBlt             Tile of GLYPH_WIDTH * GLYPH_HEIGHT pixels
+
+**/
+STATIC
+VOID
+RenderGlyph (
+  IN  UINTN                         Code,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL ForegroundColor,
+  IN  EFI_GRAPHICS_OUTPUT_BLT_PIXEL BackgroundColor,
+  OUT EFI_GRAPHICS_OUTPUT_BLT_PIXEL *GopBlt
+  )
+{
+  UINT8                            *GlyphBitmap;
+  UINTN                            Row;
+  UINTN                            Col;
+
+  GlyphBitmap = gUsStdNarrowGlyphData[Code].GlyphCol1;
+  for (Row = 0; Row < GLYPH_HEIGHT; Row++) {
+    for (Col = 0; Col < GLYPH_WIDTH; Col++) {
+      GopBlt[Row * GLYPH_WIDTH + Col] = ((GlyphBitmap[Row] & (1 << (GLYPH_WIDTH - Col - 1))) != 0) ? ForegroundColor : BackgroundColor;
+    }
+  }
+}
+
+/**
+  Get the pre-rendered tile of a glyph in the console colors.
+
+  The tile is rendered on first use and then reused for every later
+  occurrence of the same character.
+
+  @param[in] Console             Pointer to the frame buffer console
+  @param[in] Code                Index into the narrow glyph table
+
+  @retval                        Pointer to the glyph tile
+
+**/
+STATIC
+EFI_GRAPHICS_OUTPUT_BLT_PIXEL *
+GetGlyphTile (
+  IN FRAME_BUFFER_CONSOLE          *Console,
+  IN UINTN                         Code
+  )
+{
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    *Tile;
+
+  Tile = &Console->GlyphTileBuf[Code * GLYPH_WIDTH * GLYPH_HEIGHT];
+  if (Console->GlyphTileValid[Code] == 0) {
+    RenderGlyph (Code, Console->ForegroundColor, Console->BackgroundColor, Tile);
+    Console->GlyphTileValid[Code] = 1;
+  }
+
+  return Tile;
+}
+
 /**
   Draw a glyph into the frame buffer (ASCII only).
 
@@ -112,42 +214,132 @@ BltGlyphToFrameBuffer (
   IN UINTN                         OffY
   )
 {
-  UINT8                            *GlyphBitmap;
-  UINTN                            Width, Height;
-  UINTN                            Row;
-  UINTN                            Col;
+  FRAME_BUFFER_CONSOLE             *Console;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL    *Tile;
   UINTN                            Code;
-  UINTN                            Base;
   EFI_GRAPHICS_OUTPUT_BLT_PIXEL    GopBlt[GLYPH_WIDTH * GLYPH_HEIGHT];
 
   if (GfxInfoHob == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
-  Width = GLYPH_WIDTH;
-  Height = GLYPH_HEIGHT;
+  Code = GetGlyphIndex (Glyph);
 
-  // Glyph table maps to ASCII characters, index the table with the character
-  Code = (UINTN)(Glyph & 0xFF);
-  Base = 0xAF;
-  if ((Code >= Base) && (Code <= 0xF2)) {
-    Code = (0x80 - 0x20) + (Code - Base);
-  } else if ((Code >= 0x20) && (Code <= 0x7F)) {
-    Code = Code - 0x20;
+  // Use the cached tile when drawing in the console colors
+  Console = &mFbConsole;
+  if ((Console->GlyphTileBuf != NULL)
+      && (CompareMem (&ForegroundColor, &Console->ForegroundColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)) == 0)
+      && (CompareMem (&BackgroundColor, &Console->BackgroundColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)) == 0)) {
+    Tile = GetGlyphTile (Console, Code);
   } else {
-    Code = 0;
+    RenderGlyph (Code, ForegroundColor, BackgroundColor, GopBlt);
+    Tile = GopBlt;
   }
 
-  // Glyph table maps to ASCII characters, index the table with the character
-  GlyphBitmap = gUsStdNarrowGlyphData[Code].GlyphCol1;
+  return BltToFrameBuffer (GfxInfoHob, Tile, GLYPH_WIDTH, GLYPH_HEIGHT, OffX, OffY);
+}
 
-  for (Row = 0; Row < Height; Row++) {
-    for (Col = 0; Col < Width; Col++) {
-      GopBlt[Row * Width + Col] = ((GlyphBitmap[Row] & (1 << (Width - Col - 1))) != 0) ? ForegroundColor : BackgroundColor;
+/**
+  Mark console text rows as needing to be redrawn.
+
+  @param[in] Console             Pointer to the frame buffer console
+  @param[in] Top                 First row to mark
+  @param[in] Bottom              Row after the last row to mark
+
+**/
+STATIC
+VOID
+FrameBufferConsoleMarkDirty (
+  IN FRAME_BUFFER_CONSOLE  *Console,
+  IN UINTN                 Top,
+  IN UINTN                 Bottom
+  )
+{
+  if (Top < Console->DirtyTop) {
+    Console->DirtyTop = Top;
+  }
+  if (Bottom > Console->DirtyBottom) {
+    Console->DirtyBottom = Bottom;
+  }
+}
+
+/**
+  Update the frame buffer with the dirty rows of the console text buffer.
+
+  TextSwapBuf contains what *should* be displayed and TextDisplayBuf contains
+  what is currently being displayed. Only the characters that differ within
+  the dirty rows are drawn.
+
+  @param[in] Console             Pointer to the frame buffer console
+
+**/
+STATIC
+VOID
+FrameBufferConsoleFlush (
+  IN FRAME_BUFFER_CONSOLE  *Console
+  )
+{
+  UINTN                  BufX;
+  UINTN                  BufY;
+  UINTN                  BufPos;
+  UINTN                  ScreenX;
+  UINTN                  ScreenY;
+
+  if (Console->DirtyBottom > Console->Rows) {
+    Console->DirtyBottom = Console->Rows;
+  }
+
+  ScreenY = Console->OffY + Console->DirtyTop * GLYPH_HEIGHT;
+  for (BufY = Console->DirtyTop; BufY < Console->DirtyBottom; BufY++) {
+    BufPos  = BufY * Console->Cols;
+    ScreenX = Console->OffX;
+    for (BufX = 0; BufX < Console->Cols; BufX++) {
+      if (Console->TextSwapBuf[BufPos] != Console->TextDisplayBuf[BufPos]) {
+        Console->TextDisplayBuf[BufPos] = Console->TextSwapBuf[BufPos];
+        BltGlyphToFrameBuffer (Console->GfxInfoHob, Console->TextSwapBuf[BufPos],
+                               Console->ForegroundColor, Console->BackgroundColor,
+                               ScreenX, ScreenY);
+      }
+      BufPos++;
+      ScreenX += GLYPH_WIDTH;
     }
+    ScreenY += GLYPH_HEIGHT;
+  }
+
+  Console->DirtyTop    = Console->Rows;
+  Console->DirtyBottom = 0;
+}
+
+/**
+  Scroll the console text buffer up without updating the frame buffer.
+
+  @param[in] Console             Pointer to the frame buffer console
+  @param[in] ScrollAmount        Amount (in rows) to scroll
+
+**/
+STATIC
+VOID
+FrameBufferConsoleScrollText (
+  IN FRAME_BUFFER_CONSOLE  *Console,
+  IN UINTN                 ScrollAmount
+  )
+{
+  if (ScrollAmount > Console->Rows) {
+    ScrollAmount = Console->Rows;
   }
 
-  return BltToFrameBuffer (GfxInfoHob, GopBlt, Width, Height, OffX, OffY);
+  if (ScrollAmount < Console->Rows) {
+    // Move all lines in text buffer up
+    CopyMem (&Console->TextSwapBuf[0],
+             &Console->TextSwapBuf[Console->Cols * ScrollAmount],
+             Console->Cols * (Console->Rows - ScrollAmount));
+  }
+
+  // Blank remaining lines
+  ZeroMem (&Console->TextSwapBuf[Console->Cols * (Console->Rows - ScrollAmount)],
+           Console->Cols * ScrollAmount);
+
+  FrameBufferConsoleMarkDirty (Console, 0, Console->Rows);
 }
 
 /**
@@ -205,6 +397,8 @@ InitFrameBufferConsole (
   Console->Cols        = Width / GLYPH_WIDTH;
   Console->CursorX     = 0;
   Console->CursorY     = 0;
+  Console->DirtyTop    = Console->Rows;
+  Console->DirtyBottom = 0;
   Console->ForegroundColor = mColors[7];
   Console->BackgroundColor = mColors[0];
   Console->TextDisplayBuf = AllocateZeroPool (Console->Rows * Console->Cols);
@@ -214,14 +408,78 @@ InitFrameBufferConsole (
   Console->TextDrawBuf = AllocateZeroPool (Console->Rows * Console->Cols * 2);
   ASSERT (Console->TextDrawBuf != NULL);
 
+  // Glyph tile cache is optional, glyphs are expanded on the fly without it
+  Console->GlyphCount     = mNarrowFontSize / sizeof (EFI_NARROW_GLYPH);
+  Console->GlyphTileValid = AllocateZeroPool (Console->GlyphCount);
+  Console->GlyphTileBuf   = AllocatePool (Console->GlyphCount * GLYPH_WIDTH * GLYPH_HEIGHT * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+  if ((Console->GlyphTileBuf == NULL) || (Console->GlyphTileValid == NULL)) {
+    DEBUG ((DEBUG_WARN, "No glyph cache for frame buffer console\n"));
+    Console->GlyphTileBuf = NULL;
+  }
+
   if (ClearScreen) {
     // Clear screen using standard ANSI Escape Sequences 'ESC[2J'
     FrameBufferWrite (ANSI_ESCAPE_SEQ_CLEAR_SCREEN, 4);
+  } else {
+    // The logo was drawn by an earlier stage, so no cell is known to be blank
+    FrameBufferConsoleInvalidate (OffX, OffY, Width, Height);
   }
 
   return EFI_SUCCESS;
 }
 
+/**
+  Invalidate the console cells covering an area of the frame buffer.
+
+  This must be called whenever pixels are drawn outside of the console so
+  that the console does not assume those cells still show their text.
+
+  @param[in] OffX                X offset of the area (in pixels)
+  @param[in] OffY                Y offset of the area (in pixels)
+  @param[in] Width               Width of the area (in pixels)
+  @param[in] Height              Height of the area (in pixels)
+
+**/
+VOID
+EFIAPI
+FrameBufferConsoleInvalidate (
+  IN UINTN               OffX,
+  IN UINTN               OffY,
+  IN UINTN               Width,
+  IN UINTN               Height
+  )
+{
+  FRAME_BUFFER_CONSOLE   *Console;
+  UINTN                  Left;
+  UINTN                  Right;
+  UINTN                  Top;
+  UINTN                  Bottom;
+
+  Console = &mFbConsole;
+  if ((Console->Height == 0) || (Width == 0) || (Height == 0)) {
+    return;
+  }
+
+  if (((OffX + Width) <= Console->OffX) || ((OffY + Height) <= Console->OffY)) {
+    return;
+  }
+
+  Left   = (OffX > Console->OffX) ? (OffX - Console->OffX) / GLYPH_WIDTH : 0;
+  Top    = (OffY > Console->OffY) ? (OffY - Console->OffY) / GLYPH_HEIGHT : 0;
+  Right  = (OffX + Width - Console->OffX + GLYPH_WIDTH - 1) / GLYPH_WIDTH;
+  Bottom = (OffY + Height - Console->OffY + GLYPH_HEIGHT - 1) / GLYPH_HEIGHT;
+  if (Right > Console->Cols) {
+    Right = Console->Cols;
+  }
+  if (Bottom > Console->Rows) {
+    Bottom = Console->Rows;
+  }
+
+  for (; (Top < Bottom) && (Left < Right); Top++) {
+    SetMem (&Console->TextDisplayBuf[Top * Console->Cols + Left], Right - Left, TEXT_CELL_STALE);
+  }
+}
+
 /**
   Scroll the console area of the screen up.
 
@@ -237,54 +495,14 @@ FrameBufferConsoleScroll (
   )
 {
   FRAME_BUFFER_CONSOLE   *Console;
-  UINTN                  BufX;
-  UINTN                  BufY;
-  UINTN                  BufPos;
-  UINTN                  ScreenX;
-  UINTN                  ScreenY;
 
   Console = &mFbConsole;
   if (Console->Height == 0) {
     return EFI_UNSUPPORTED;
   }
 
-  if (ScrollAmount > Console->Rows) {
-    ScrollAmount = Console->Rows;
-  }
-
-  if (ScrollAmount < Console->Rows) {
-    // Move all lines in text buffer up
-    CopyMem (&Console->TextSwapBuf[0],
-             &Console->TextDisplayBuf[Console->Cols * ScrollAmount],
-             Console->Cols * (Console->Rows - ScrollAmount));
-  }
-
-  // Blank remaining lines
-  ZeroMem (&Console->TextSwapBuf[Console->Cols * (Console->Rows - ScrollAmount)],
-           Console->Cols * ScrollAmount);
-
-  // Write text buffer to screen
-  //
-  // Note: At this point, TextDisplayBuf contains what is currently being
-  // displayed and TextSwapBuf contains what *should* be displayed. Step through
-  // every character of the buffer and update the framebuffer with any
-  // differences.
-  BufPos = 0;
-  ScreenY = Console->OffY;
-  for (BufY = 0; BufY < Console->Rows; BufY++) {
-    ScreenX = Console->OffX;
-    for (BufX = 0; BufX < Console->Cols; BufX++) {
-      if (Console->TextSwapBuf[BufPos] != Console->TextDisplayBuf[BufPos]) {
-        Console->TextDisplayBuf[BufPos] = Console->TextSwapBuf[BufPos];
-        BltGlyphToFrameBuffer (Console->GfxInfoHob, Console->TextSwapBuf[BufPos],
-                               Console->ForegroundColor, Console->BackgroundColor,
-                               ScreenX, ScreenY);
-      }
-      BufPos++;
-      ScreenX += GLYPH_WIDTH;
-    }
-    ScreenY += GLYPH_HEIGHT;
-  }
+  FrameBufferConsoleScrollText (Console, ScrollAmount);
+  FrameBufferConsoleFlush (Console);
 
   return EFI_SUCCESS;
 }
@@ -316,7 +534,6 @@ FrameBufferWrite (
   )
 {
   FRAME_BUFFER_CONSOLE *Console;
-  EFI_STATUS            Status;
   UINTN                 Pos;
   UINTN                 Length;
   EFI_PEI_GRAPHICS_INFO_HOB  *GfxInfoHob;
@@ -334,6 +551,9 @@ FrameBufferWrite (
   if ((NumberOfBytes == 4) && (CompareMem (ANSI_ESCAPE_SEQ_CLEAR_SCREEN, Buffer, 4)) == 0) {
     // Clear screen
     SetMem (Console->TextDisplayBuf, Console->Rows * Console->Cols, 0);
+    SetMem (Console->TextSwapBuf, Console->Rows * Console->Cols, 0);
+    Console->DirtyTop    = Console->Rows;
+    Console->DirtyBottom = 0;
     // Zero framebuffer
     GfxInfoHob = Console->GfxInfoHob;
     Length = (GfxInfoHob->GraphicsMode.HorizontalResolution * GfxInfoHob->GraphicsMode.PixelsPerScanLine) * 4;
@@ -343,6 +563,11 @@ FrameBufferWrite (
     return NumberOfBytes;
   }
 
+  //
+  // Only update the text buffer here. The frame buffer is updated once
+  // at the end, so that scrolling through several lines within a single
+  // write costs a single redraw.
+  //
   for (Pos = 0; Pos < NumberOfBytes; Pos++) {
     // Continue on next line when cursor overflows columns
     if (Console->CursorX >= Console->Cols) {
@@ -352,7 +577,7 @@ FrameBufferWrite (
 
     // Create new line when cursor overflows rows
     if (Console->CursorY >= Console->Rows) {
-      FrameBufferConsoleScroll (1);
+      FrameBufferConsoleScrollText (Console, 1);
       Console->CursorY = Console->Rows - 1;
       Console->CursorX = 0;
     }
@@ -378,18 +603,14 @@ FrameBufferWrite (
       // Carriage Return
       Console->CursorX = 0;
     } else {
-      Console->TextDisplayBuf[Console->CursorY * Console->Cols + Console->CursorX] = Buffer[Pos];
-      Status = BltGlyphToFrameBuffer (Console->GfxInfoHob, Buffer[Pos],
-                                      Console->ForegroundColor, Console->BackgroundColor,
-                                      Console->OffX + Console->CursorX * GLYPH_WIDTH,
-                                      Console->OffY + Console->CursorY * GLYPH_HEIGHT);
-      if (Status != EFI_SUCCESS) {
-        break;
-      }
+      Console->TextSwapBuf[Console->CursorY * Console->Cols + Console->CursorX] = Buffer[Pos];
+      FrameBufferConsoleMarkDirty (Console, Console->CursorY, Console->CursorY + 1);
       Console->CursorX++;
     }
   }
 
+  FrameBufferConsoleFlush (Console);
+
   return Pos;
 }
 
@@ -464,6 +685,9 @@ DrawFrameBuffer (
     }
   }
 
+  FrameBufferConsoleInvalidate (Console->OffX + OffX * GLYPH_WIDTH, Console->OffY + OffY * GLYPH_HEIGHT,
+                                Col * GLYPH_WIDTH, Row * GLYPH_HEIGHT);
+
   return EFI_SUCCESS;
 }
 
@@ -8,11 +8,181 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <PiPei.h>
 
-#include <Library/HobLib.h>
+#include <Library/BlHobLib.h>
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
 #include <Library/BootloaderCommonLib.h>
 
+#define HOB_INDEX_TYPE_NUM        16
+#define HOB_INDEX_GUID_BUCKETS    64
+#define HOB_INDEX_NONE            MAX_UINT32
+
+typedef struct {
+  UINT8                     *Hob;
+  UINT32                     NextType;
+  UINT32                     NextGuid;
+} HOB_INDEX_ENTRY;
+
+typedef struct {
+  UINT8                     *HobList;
+  UINT8                     *HobEnd;
+  UINT32                     Count;
+  UINT32                     TypeHead[HOB_INDEX_TYPE_NUM];
+  UINT32                     GuidHead[HOB_INDEX_GUID_BUCKETS];
+  HOB_INDEX_ENTRY            Entry[0];
+} HOB_INDEX;
+
+//
+// Only set by BuildHobIndex (), so it stays NULL in execute-in-place stages.
+//
+STATIC HOB_INDEX            *mHobIndex = NULL;
+
+/**
+  Get the hash bucket of a GUID in the HOB index.
+
+  @param  Guid          The GUID to hash.
+
+  @return The hash bucket index.
+
+**/
+STATIC
+UINT32
+GetGuidBucket (
+  IN CONST EFI_GUID         *Guid
+  )
+{
+  CONST UINT32  *Data;
+  UINT32         Hash;
+
+  Data = (CONST UINT32 *) Guid;
+  Hash = Data[0] ^ Data[1] ^ Data[2] ^ Data[3];
+  Hash ^= Hash >> 16;
+  Hash ^= Hash >> 8;
+  return Hash & (HOB_INDEX_GUID_BUCKETS - 1);
+}
+
+/**
+  Build a lookup index for a HOB list.
+
+  Once built, GetNextHob (), GetNextGuidHob () and the functions based on
+  them look up HOBs in this list through the index instead of walking the
+  list. The index is rebuilt automatically when HOBs are appended to the list.
+  Only one HOB list can be indexed at a time, building an index for another
+  list replaces the previous one.
+
+  This function must not be called from execute-in-place stages.
+
+  @param[in]  HobList       The HOB list to index.
+
+  @retval EFI_SUCCESS            The index was built.
+  @retval EFI_INVALID_PARAMETER  HobList is NULL.
+  @retval EFI_OUT_OF_RESOURCES   No enough memory for the index.
+
+**/
+EFI_STATUS
+EFIAPI
+BuildHobIndex (
+  IN CONST VOID             *HobList
+  )
+{
+  EFI_PEI_HOB_POINTERS  Hob;
+  HOB_INDEX            *Index;
+  HOB_INDEX_ENTRY      *Entry;
+  UINT32                Count;
+  UINT32                Idx;
+  UINT32                Bucket;
+  UINT16                Type;
+
+  if (mHobIndex != NULL) {
+    FreePool (mHobIndex);
+    mHobIndex = NULL;
+  }
+
+  if (HobList == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Count   = 0;
+  Hob.Raw = (UINT8 *) HobList;
+  while (!END_OF_HOB_LIST (Hob)) {
+    Count++;
+    Hob.Raw = GET_NEXT_HOB (Hob);
+  }
+
+  Index = AllocatePool (sizeof (HOB_INDEX) + Count * sizeof (HOB_INDEX_ENTRY));
+  if (Index == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Index->HobList = (UINT8 *) HobList;
+  Index->HobEnd  = Hob.Raw;
+  Index->Count   = Count;
+  SetMem32 (Index->TypeHead, sizeof (Index->TypeHead), HOB_INDEX_NONE);
+  SetMem32 (Index->GuidHead, sizeof (Index->GuidHead), HOB_INDEX_NONE);
+
+  Hob.Raw = (UINT8 *) HobList;
+  for (Idx = 0; Idx < Count; Idx++) {
+    Index->Entry[Idx].Hob = Hob.Raw;
+    Hob.Raw = GET_NEXT_HOB (Hob);
+  }
+
+  //
+  // Link the entries backwards so that every chain is in HOB list order.
+  //
+  for (Idx = Count; Idx > 0; Idx--) {
+    Entry           = &Index->Entry[Idx - 1];
+    Entry->NextType = HOB_INDEX_NONE;
+    Entry->NextGuid = HOB_INDEX_NONE;
+    Type            = ((EFI_HOB_GENERIC_HEADER *) Entry->Hob)->HobType;
+    if (Type < HOB_INDEX_TYPE_NUM) {
+      Entry->NextType       = Index->TypeHead[Type];
+      Index->TypeHead[Type] = Idx - 1;
+    }
+    if (Type == EFI_HOB_TYPE_GUID_EXTENSION) {
+      Bucket                  = GetGuidBucket (&((EFI_HOB_GUID_TYPE *) Entry->Hob)->Name);
+      Entry->NextGuid         = Index->GuidHead[Bucket];
+      Index->GuidHead[Bucket] = Idx - 1;
+    }
+  }
+
+  mHobIndex = Index;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Get the HOB index covering a HOB pointer.
+
+  If HOBs have been appended to the indexed list since the index was built,
+  the index is rebuilt first.
+
+  @param  HobStart      A HOB pointer within the HOB list.
+
+  @return The HOB index, or NULL if HobStart is not in the indexed HOB list.
+
+**/
+STATIC
+HOB_INDEX *
+GetHobIndex (
+  IN CONST VOID             *HobStart
+  )
+{
+  if (mHobIndex == NULL) {
+    return NULL;
+  }
+
+  if (((UINT8 *) HobStart < mHobIndex->HobList) || ((UINT8 *) HobStart > mHobIndex->HobEnd)) {
+    return NULL;
+  }
+
+  if (((EFI_HOB_GENERIC_HEADER *) mHobIndex->HobEnd)->HobType != EFI_HOB_TYPE_END_OF_HOB_LIST) {
+    BuildHobIndex (mHobIndex->HobList);
+  }
+
+  return mHobIndex;
+}
+
 /**
   Returns the pointer to the HOB list.
 
@@ -55,9 +225,21 @@ GetNextHob (
   )
 {
   EFI_PEI_HOB_POINTERS  Hob;
+  HOB_INDEX            *Index;
+  UINT32                Idx;
 
   ASSERT (HobStart != NULL);
 
+  Index = GetHobIndex (HobStart);
+  if ((Index != NULL) && (Type < HOB_INDEX_TYPE_NUM)) {
+    for (Idx = Index->TypeHead[Type]; Idx != HOB_INDEX_NONE; Idx = Index->Entry[Idx].NextType) {
+      if (Index->Entry[Idx].Hob >= (UINT8 *) HobStart) {
+        return Index->Entry[Idx].Hob;
+      }
+    }
+    return NULL;
+  }
+
   Hob.Raw = (UINT8 *) HobStart;
   //
   // Parse the HOB list until end of list or matching type is found.
@@ -126,6 +308,20 @@ GetNextGuidHob (
   )
 {
   EFI_PEI_HOB_POINTERS  GuidHob;
+  HOB_INDEX            *Index;
+  HOB_INDEX_ENTRY      *Entry;
+  UINT32                Idx;
+
+  Index = GetHobIndex (HobStart);
+  if (Index != NULL) {
+    for (Idx = Index->GuidHead[GetGuidBucket (Guid)]; Idx != HOB_INDEX_NONE; Idx = Entry->NextGuid) {
+      Entry = &Index->Entry[Idx];
+      if ((Entry->Hob >= (UINT8 *) HobStart) && CompareGuid (Guid, &((EFI_HOB_GUID_TYPE *) Entry->Hob)->Name)) {
+        return Entry->Hob;
+      }
+    }
+    return NULL;
+  }
 
   GuidHob.Raw = (UINT8 *) HobStart;
   while ((GuidHob.Raw = GetNextHob (EFI_HOB_TYPE_GUID_EXTENSION, GuidHob.Raw)) != NULL) {
@@ -232,6 +232,12 @@ LoadBzImage (
     BootParamSize = 5 * 512;
   }
 
+  //
+  // The protected-mode kernel is always copied to LINUX_KERNEL_BASE, even for
+  // relocatable kernels. Running it from the image buffer would let the kernel
+  // decompress over InitSize bytes of payload heap, which may still hold the
+  // command line, InitRd or page tables in use at hand-off.
+  //
   KernelBuf  = (VOID *) (UINTN)LINUX_KERNEL_BASE;
   KernelSize = Bp->Hdr.SysSize * 16;
   CopyMem (KernelBuf, (UINT8 *)ImageBase + BootParamSize, KernelSize);
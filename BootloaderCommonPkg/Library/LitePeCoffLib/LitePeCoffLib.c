@@ -119,6 +119,9 @@ PeCoffLoaderGetEntryPoint (
   Performs an specific relocation fpr PECOFF images. The caller needs to
   allocate enough buffer at the PreferedImageBase
 
+  If the image is already located at its linked image base, the relocation
+  data is not processed.
+
   @param  ImageBase        Pointer to the current image base.
 
   @return Status code.
@@ -202,6 +205,15 @@ PeCoffRelocateImage (
     return RETURN_UNSUPPORTED;
   }
 
+  //
+  // Images are linked at their expected load address at build time, so in the
+  // common case there is nothing to fix up. Skip walking the relocation blocks
+  // and only fall back to the full relocation when the image has moved.
+  //
+  if (FixupDelta == 0) {
+    RelocSectionSize = 0;
+  }
+
   // This seems to be a bug in the way MS generates the reloc fixup blocks.
   // After we have gone thru all the fixup blocks in the .reloc section, the
   // variable RelocSectionSize should ideally go to zero. But I have found some orphan
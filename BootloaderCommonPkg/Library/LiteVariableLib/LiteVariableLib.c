@@ -48,9 +48,54 @@ GetVariableInstance (
   return VarInstance;
 }
 
+/**
+  This function returns the RAM mirror of the variable store region.
+
+  The mirror is only created once system memory is available. It is rebuilt
+  from flash whenever a new stage accesses the store, since the buffer that
+  was allocated by a previous stage might not be preserved.
+
+  @param[in]  VarInstance   Variable instance.
+
+  @retval     Mirror base address, or NULL if flash has to be accessed directly.
+
+**/
+VOID *
+GetVariableStoreMirror (
+  IN  VARIABLE_INSTANCE  *VarInstance
+  )
+{
+  LOADER_STAGE   Stage;
+  VOID          *Mirror;
+
+  Stage = GetLoaderStage ();
+  if (Stage < LOADER_STAGE_2) {
+    return NULL;
+  }
+
+  if ((VarInstance->MirrorBase != 0) && (VarInstance->MirrorStage == (UINT8)Stage)) {
+    return (VOID *)(UINTN)VarInstance->MirrorBase;
+  }
+
+  Mirror = AllocatePool (VarInstance->StoreSize);
+  if (Mirror == NULL) {
+    return NULL;
+  }
+
+  CopyMem (Mirror, (VOID *)(UINTN)VarInstance->StoreBase, VarInstance->StoreSize);
+  VarInstance->MirrorBase  = (UINT32)(UINTN)Mirror;
+  VarInstance->MirrorStage = (UINT8)Stage;
+  VarInstance->IndexValid  = FALSE;
+
+  return Mirror;
+}
+
 /**
   This function retrieves the variable store region base and size.
 
+  If a RAM mirror is available, the mirror base is returned so that all
+  variable parsing is done from memory instead of the flash device.
+
   @param[in,out]  Size  Pointer to receive variable store size.
 
   @retval               Variable store region base address.
@@ -62,6 +107,7 @@ GetVaraibelStoreBase (
   )
 {
   VARIABLE_INSTANCE  *VarInstance;
+  VOID               *Mirror;
 
   VarInstance = GetVariableInstance ();
   if (VarInstance == NULL) {
@@ -72,9 +118,65 @@ GetVaraibelStoreBase (
     *Size = VarInstance->StoreSize;
   }
 
+  Mirror = GetVariableStoreMirror (VarInstance);
+  if (Mirror != NULL) {
+    return Mirror;
+  }
+
   return (VOID *)(UINTN)VarInstance->StoreBase;
 }
 
+/**
+  This function translates a variable store address into the flash address.
+
+  The cached lookup index is invalidated if the caller is going to modify
+  the indexed variable store. Writes into the other store, such as the
+  copies made by Reclaim, keep the index.
+
+  @param[in]  VariableStore     Address inside the variable store or its RAM mirror.
+  @param[out] Mirror            Pointer to receive the mirror address, or NULL if
+                                the address is not mirrored.
+
+  @retval     Flash address of the variable store location.
+
+**/
+VOID *
+GetVariableStoreFlashAddress (
+  IN  VOID     *VariableStore,
+  OUT VOID    **Mirror
+  )
+{
+  VARIABLE_INSTANCE      *VarInstance;
+  VARIABLE_STORE_HEADER  *IndexStore;
+  UINT32                  Offset;
+
+  *Mirror     = NULL;
+  VarInstance = GetVariableInstance ();
+  if (VarInstance == NULL) {
+    return VariableStore;
+  }
+
+  if (VarInstance->IndexValid) {
+    IndexStore = (VARIABLE_STORE_HEADER *)(UINTN)VarInstance->IndexStore;
+    if (((UINT8 *)VariableStore >= (UINT8 *)IndexStore) &&
+        ((UINT8 *)VariableStore < (UINT8 *)IndexStore + IndexStore->Size)) {
+      VarInstance->IndexValid = FALSE;
+    }
+  }
+
+  if ((VarInstance->MirrorBase == 0) || (VarInstance->MirrorStage != (UINT8)GetLoaderStage ())) {
+    return VariableStore;
+  }
+
+  Offset = (UINT32)(UINTN)VariableStore - VarInstance->MirrorBase;
+  if (Offset >= VarInstance->StoreSize) {
+    return VariableStore;
+  }
+
+  *Mirror = VariableStore;
+  return (VOID *)(UINTN)(VarInstance->StoreBase + Offset);
+}
+
 /**
   This function erases the specified variable store region.
 
@@ -96,7 +198,9 @@ EraseVariableStore (
   UINT32              BiosRgnOffset;
   UINT32              RgnBase;
   UINT32              RgnSize;
+  VOID               *Mirror;
 
+  VariableStore = GetVariableStoreFlashAddress (VariableStore, &Mirror);
   DEBUG ((DEBUG_INFO, "  SPI ERASE: %08X  %08X\n", (UINT32)(UINTN)VariableStore, Length));
   SpiService = (SPI_FLASH_SERVICE *)GetServiceBySignature (SPI_FLASH_SERVICE_SIGNATURE);
   if (SpiService != NULL) {
@@ -106,6 +210,9 @@ EraseVariableStore (
       BiosRgnOffset = (UINT32)((UINT32)(UINTN)VariableStore + RgnSize);
       Status = SpiService->SpiErase (FlashRegionBios, BiosRgnOffset, Length);
       AsmFlushCacheRange (VariableStore, Length);
+      if (Mirror != NULL) {
+        CopyMem (Mirror, VariableStore, Length);
+      }
     }
   } else {
     Status = EFI_NOT_AVAILABLE_YET;
@@ -136,7 +243,9 @@ WriteVariableStore (
   UINT32              BiosRgnOffset;
   UINT32              RgnBase;
   UINT32              RgnSize;
+  VOID               *Mirror;
 
+  VariableStore = GetVariableStoreFlashAddress (VariableStore, &Mirror);
   DEBUG ((DEBUG_INFO, "  SPI WRITE: %08X  %08X\n", (UINT32)(UINTN)VariableStore, Length));
   SpiService = (SPI_FLASH_SERVICE *)GetServiceBySignature (SPI_FLASH_SERVICE_SIGNATURE);
   if (SpiService != NULL) {
@@ -146,6 +255,12 @@ WriteVariableStore (
       BiosRgnOffset = (UINT32)((UINT32)(UINTN)VariableStore + RgnSize);
       Status = SpiService->SpiWrite (FlashRegionBios, BiosRgnOffset, Length, Buffer);
       AsmFlushCacheRange (VariableStore, Length);
+      if (Mirror != NULL) {
+        //
+        // Refresh the mirror from flash so that it reflects what was really programmed
+        //
+        CopyMem (Mirror, VariableStore, Length);
+      }
     }
   } else {
     Status = EFI_NOT_AVAILABLE_YET;
@@ -321,6 +436,146 @@ InitializeVariableStore (
   return EFI_SUCCESS;
 }
 
+/**
+  Calculate the hash value of a variable name used by the lookup index.
+
+  @param[in]  VariableName    Null-terminated variable name.
+
+  @retval     Hash value of the variable name.
+
+**/
+UINT32
+GetVariableNameHash (
+  IN CONST CHAR8    *VariableName
+  )
+{
+  UINT32  Hash;
+
+  //
+  // FNV-1a
+  //
+  Hash = 0x811C9DC5;
+  while (*VariableName != 0) {
+    Hash = (Hash ^ (UINT8)*VariableName) * 0x01000193;
+    VariableName++;
+  }
+
+  return Hash;
+}
+
+/**
+  Build the variable name hash index for the active variable store.
+
+  @param[in]  VarInstance       Variable instance.
+  @param[in]  VarStoreHdrPtr    Active variable store header pointer.
+
+  @retval EFI_SUCCESS           The index was built successfully.
+  @retval EFI_VOLUME_CORRUPTED  Variable store is corrupted.
+  @retval EFI_OUT_OF_RESOURCES  Too many variables to fit into the index.
+
+**/
+EFI_STATUS
+BuildVariableIndex (
+  IN  VARIABLE_INSTANCE      *VarInstance,
+  IN  VARIABLE_STORE_HEADER  *VarStoreHdrPtr
+  )
+{
+  VARIABLE_HEADER        *VarHdrPtr;
+  UINT8                  *VarEndPtr;
+  UINT8                   State;
+  UINT16                  Count;
+
+  VarInstance->IndexValid = FALSE;
+  VarHdrPtr = (VARIABLE_HEADER *)&VarStoreHdrPtr[1];
+  VarEndPtr = (UINT8 *)VarStoreHdrPtr + VarStoreHdrPtr->Size;
+
+  Count = 0;
+  while ((UINT8 *)VarHdrPtr < VarEndPtr) {
+    State = VarHdrPtr->State;
+    if (!IS_HEADER_VALID (State)) {
+      break;
+    }
+
+    if (VarHdrPtr->StartId != VARIABLE_DATA) {
+      return EFI_VOLUME_CORRUPTED;
+    }
+
+    if (IS_DATA_VALID (State) && !IS_DELETED (State)) {
+      if (Count >= VARIABLE_INDEX_ENTRY_NUM) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+      VarInstance->Index[Count].Hash   = GetVariableNameHash ((CONST CHAR8 *)&VarHdrPtr[1]);
+      VarInstance->Index[Count].Offset = (UINT32)((UINT8 *)VarHdrPtr - (UINT8 *)VarStoreHdrPtr);
+      Count++;
+    }
+
+    VarHdrPtr = (VARIABLE_HEADER *) ((UINT8 *)&VarHdrPtr[1] + VarHdrPtr->DataSize);
+  }
+
+  VarInstance->IndexCount = Count;
+  VarInstance->IndexStore = (UINT32)(UINTN)VarStoreHdrPtr;
+  VarInstance->IndexValid = TRUE;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Find a variable through the variable name hash index.
+
+  The index is rebuilt on demand if the variable store was modified since
+  the last lookup.
+
+  @param[in]  VarStoreHdrPtr    Active variable store header pointer.
+  @param[in]  VariableName      Name of Variable to be found.
+  @param[out] FindVarHdrPtr     Variable header pointer if found, otherwise NULL.
+
+  @retval EFI_SUCCESS           The index was searched, FindVarHdrPtr is updated.
+  @retval EFI_UNSUPPORTED       The index is not usable and a full scan is required.
+
+**/
+EFI_STATUS
+FindVariableByIndex (
+  IN  VARIABLE_STORE_HEADER  *VarStoreHdrPtr,
+  IN  CHAR8                  *VariableName,
+  OUT VARIABLE_HEADER       **FindVarHdrPtr
+  )
+{
+  VARIABLE_INSTANCE      *VarInstance;
+  VARIABLE_HEADER        *VarHdrPtr;
+  EFI_STATUS              Status;
+  UINT32                  Hash;
+  UINT16                  Idx;
+
+  VarInstance = GetVariableInstance ();
+  if (VarInstance == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (!VarInstance->IndexValid || (VarInstance->IndexStore != (UINT32)(UINTN)VarStoreHdrPtr)) {
+    Status = BuildVariableIndex (VarInstance, VarStoreHdrPtr);
+    if (EFI_ERROR (Status)) {
+      return EFI_UNSUPPORTED;
+    }
+  }
+
+  *FindVarHdrPtr = NULL;
+  Hash = GetVariableNameHash (VariableName);
+  for (Idx = 0; Idx < VarInstance->IndexCount; Idx++) {
+    if (VarInstance->Index[Idx].Hash != Hash) {
+      continue;
+    }
+    VarHdrPtr = (VARIABLE_HEADER *)((UINT8 *)VarStoreHdrPtr + VarInstance->Index[Idx].Offset);
+    if (AsciiStrCmp ((VOID *)&VarHdrPtr[1], VariableName) == 0) {
+      *FindVarHdrPtr = VarHdrPtr;
+      if (!IS_IN_MIGRATION (VarHdrPtr->State)) {
+        break;
+      }
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
 
   This internal function finds variable in storage blocks.
@@ -363,6 +618,7 @@ InternalGetVariable (
   UINT32                  VariableNameLen;
   UINT32                  VariableDataLen;
   UINTN                   DataSizeIn;
+  EFI_STATUS              Status;
 
   if ((DataSize == NULL) || (VariableName == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -374,35 +630,39 @@ InternalGetVariable (
   }
 
   VariableNameLen = (UINT32)AsciiStrLen (VariableName) + 1;
-  VarHdrPtr = (VARIABLE_HEADER *)&VarStoreHdrPtr[1];
-  VarEndPtr = (UINT8 *)VarStoreHdrPtr + VarStoreHdrPtr->Size;
 
-  FindVarHdrPtr = NULL;
-  while ((UINT8 *)VarHdrPtr < VarEndPtr) {
-    State = VarHdrPtr->State;
-    if (!IS_HEADER_VALID (State)) {
-      break;
-    }
+  Status = FindVariableByIndex (VarStoreHdrPtr, VariableName, &FindVarHdrPtr);
+  if (EFI_ERROR (Status)) {
+    VarHdrPtr = (VARIABLE_HEADER *)&VarStoreHdrPtr[1];
+    VarEndPtr = (UINT8 *)VarStoreHdrPtr + VarStoreHdrPtr->Size;
 
-    if (VarHdrPtr->StartId != VARIABLE_DATA) {
-      VarHdrPtr = NULL;
-      break;
-    }
+    FindVarHdrPtr = NULL;
+    while ((UINT8 *)VarHdrPtr < VarEndPtr) {
+      State = VarHdrPtr->State;
+      if (!IS_HEADER_VALID (State)) {
+        break;
+      }
 
-    if (IS_DATA_VALID (State) && !IS_DELETED (State)) {
-      if (AsciiStrCmp ((VOID *)&VarHdrPtr[1], VariableName) == 0) {
-        FindVarHdrPtr = VarHdrPtr;
-        if (!IS_IN_MIGRATION (State)) {
-          break;
+      if (VarHdrPtr->StartId != VARIABLE_DATA) {
+        VarHdrPtr = NULL;
+        break;
+      }
+
+      if (IS_DATA_VALID (State) && !IS_DELETED (State)) {
+        if (AsciiStrCmp ((VOID *)&VarHdrPtr[1], VariableName) == 0) {
+          FindVarHdrPtr = VarHdrPtr;
+          if (!IS_IN_MIGRATION (State)) {
+            break;
+          }
         }
       }
-    }
 
-    VarHdrPtr = (VARIABLE_HEADER *) ((UINT8 *)&VarHdrPtr[1] + VarHdrPtr->DataSize);
-  }
+      VarHdrPtr = (VARIABLE_HEADER *) ((UINT8 *)&VarHdrPtr[1] + VarHdrPtr->DataSize);
+    }
 
-  if (VarHdrPtr == NULL) {
-    return EFI_VOLUME_CORRUPTED;
+    if (VarHdrPtr == NULL) {
+      return EFI_VOLUME_CORRUPTED;
+    }
   }
 
   if (FindVarHdrPtr == NULL) {
@@ -26,10 +26,33 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 ///
 #define VARIABLE_INSTANCE_SIGNATURE  SIGNATURE_32 ('V', 'A', 'R', 'I')
 
+///
+/// Maximum number of variables tracked by the name hash index.
+/// Lookups fall back to a linear scan of the RAM mirror when it overflows.
+///
+#define VARIABLE_INDEX_ENTRY_NUM     64
+
+typedef struct {
+  UINT32                Hash;
+  UINT32                Offset;
+} VARIABLE_INDEX_ENTRY;
+
 typedef struct {
   UINT32                Signature;
   UINT32                StoreSize;
   UINT32                StoreBase;
+  ///
+  /// RAM copy of the whole variable region and the stage that allocated it.
+  ///
+  UINT32                MirrorBase;
+  UINT8                 MirrorStage;
+  BOOLEAN               IndexValid;
+  UINT16                IndexCount;
+  ///
+  /// Active store header the index offsets are relative to.
+  ///
+  UINT32                IndexStore;
+  VARIABLE_INDEX_ENTRY  Index[VARIABLE_INDEX_ENTRY_NUM];
 } VARIABLE_INSTANCE;
 
 #endif
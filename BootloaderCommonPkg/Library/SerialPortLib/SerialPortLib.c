@@ -35,6 +35,12 @@
 #define LSR_RXDA                0x01
 #define DLAB                    0x01
 #define UART_MAGIC              0x55
+#define EIR_FIFO_ENABLED        0xC0
+
+//
+// 16550 transmit FIFO depth
+//
+#define UART_TX_FIFO_SIZE       16
 
 UINTN   gBps      = 115200;
 UINT8   gData     = 8;
@@ -182,21 +188,38 @@ SerialPortWrite (
 {
   UINTN  Result;
   UINT8  Data;
+  UINTN  FifoSize;
+  UINTN  FifoLeft;
 
   if (NULL == Buffer) {
     return 0;
   }
 
-  Result = NumberOfBytes;
+  //
+  // When the transmit FIFO is enabled, TXRDY indicates that the whole FIFO
+  // is empty, so up to FIFO depth bytes can be pushed per status check.
+  // Fall back to one byte per check if the FIFO is not enabled.
+  //
+  if ((SerialPortReadRegister (EIR_OFFSET) & EIR_FIFO_ENABLED) == EIR_FIFO_ENABLED) {
+    FifoSize = UART_TX_FIFO_SIZE;
+  } else {
+    FifoSize = 1;
+  }
 
+  Result   = NumberOfBytes;
+  FifoLeft = 0;
   while (NumberOfBytes--) {
     //
     // Wait for the serail port to be ready.
     //
-    do {
-      Data = SerialPortReadRegister (LSR_OFFSET);
-    } while ((Data & LSR_TXRDY) == 0);
+    if (FifoLeft == 0) {
+      do {
+        Data = SerialPortReadRegister (LSR_OFFSET);
+      } while ((Data & LSR_TXRDY) == 0);
+      FifoLeft = FifoSize;
+    }
     SerialPortWriteRegister (0, *Buffer++);
+    FifoLeft--;
   }
 
   return Result;
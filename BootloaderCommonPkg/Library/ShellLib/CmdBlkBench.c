@@ -0,0 +1,484 @@
+/** @file
+  Shell command `blkbench` to measure block device read performance.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Library/BootloaderCommonLib.h>
+#include <Library/ShellLib.h>
+#include <Library/MediaAccessLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/TimerLib.h>
+#include <Library/ConsoleInLib.h>
+#include <Guid/OsBootOptionGuid.h>
+#include <Library/BootOptionLib.h>
+#include <Guid/DeviceTableHobGuid.h>
+
+#define BLK_BENCH_MAX_REQ_SIZE     SIZE_1MB
+#define BLK_BENCH_DEF_REQ_COUNT    64
+#define BLK_BENCH_HIST_BUCKETS     16
+#define BLK_BENCH_RANDOM_SEED      0x2545F491
+
+//
+// Request sizes swept for every device. Sizes smaller than the device
+// block size are rounded up to one block.
+//
+STATIC CONST UINT32  mBlkBenchReqSize[] = {
+  0x200, SIZE_4KB, SIZE_16KB, SIZE_64KB, SIZE_256KB, SIZE_1MB
+};
+
+typedef struct {
+  UINT32   ReqSize;
+  UINT32   Count;
+  UINT64   TotalNs;
+  UINT64   MinNs;
+  UINT64   MaxNs;
+  UINT32   Hist[BLK_BENCH_HIST_BUCKETS];
+} BLK_BENCH_RESULT;
+
+/**
+  Benchmark block device read performance
+
+  @param[in]  Shell        shell instance
+  @param[in]  Argc         number of command line arguments
+  @param[in]  Argv         command line arguments
+
+  @retval EFI_SUCCESS
+
+**/
+EFI_STATUS
+EFIAPI
+ShellCommandBlkBenchFunc (
+  IN SHELL  *Shell,
+  IN UINTN   Argc,
+  IN CHAR16 *Argv[]
+  );
+
+CONST SHELL_COMMAND ShellCommandBlkBench = {
+  L"blkbench",
+  L"Block device read benchmark",
+  &ShellCommandBlkBenchFunc
+};
+
+/**
+  Get the next value from a xorshift pseudo random sequence.
+
+  A fixed seed is used so that the random pattern is identical across runs
+  and results can be compared between releases.
+
+  @param[in, out]  State   Random generator state
+
+  @retval          Next pseudo random value
+
+**/
+STATIC
+UINT32
+BlkBenchRandom (
+  IN OUT UINT32  *State
+  )
+{
+  UINT32  Value;
+
+  Value  = *State;
+  Value ^= Value << 13;
+  Value ^= Value >> 17;
+  Value ^= Value << 5;
+  *State = Value;
+  return Value;
+}
+
+/**
+  Get the histogram bucket for a request latency.
+
+  Bucket N holds latencies in [2^(N-1), 2^N) microseconds, bucket 0 holds
+  latencies below 1us and the last bucket holds everything above.
+
+  @param[in]  LatencyNs   Request latency in nanoseconds
+
+  @retval     Histogram bucket index
+
+**/
+STATIC
+UINT32
+BlkBenchHistBucket (
+  IN UINT64  LatencyNs
+  )
+{
+  UINT64  LatencyUs;
+  UINT32  Bucket;
+
+  LatencyUs = DivU64x32 (LatencyNs, 1000);
+  Bucket    = 0;
+  while ((LatencyUs != 0) && (Bucket < BLK_BENCH_HIST_BUCKETS - 1)) {
+    LatencyUs = RShiftU64 (LatencyUs, 1);
+    Bucket++;
+  }
+  return Bucket;
+}
+
+/**
+  Run one read pass on the current media device.
+
+  @param[in]  HwPart      HW partition to read from
+  @param[in]  BlockInfo   Partition block information
+  @param[in]  Random      TRUE for random LBAs, FALSE for sequential LBAs
+  @param[in]  Buffer      Read buffer of at least Result->ReqSize bytes
+  @param[in, out] Result  Request size and count on input, statistics on output
+
+  @retval EFI_SUCCESS     All requests completed
+  @retval Others          A read request failed
+
+**/
+STATIC
+EFI_STATUS
+BlkBenchRun (
+  IN     UINT32              HwPart,
+  IN     DEVICE_BLOCK_INFO  *BlockInfo,
+  IN     BOOLEAN             Random,
+  IN     VOID               *Buffer,
+  IN OUT BLK_BENCH_RESULT   *Result
+  )
+{
+  EFI_STATUS   Status;
+  UINT32       Index;
+  UINT32       ReqBlocks;
+  UINT64       Slots;
+  EFI_LBA      Lba;
+  UINT32       Seed;
+  UINT64       Start;
+  UINT64       LatencyNs;
+
+  ReqBlocks = Result->ReqSize / BlockInfo->BlockSize;
+  Slots     = DivU64x32 (BlockInfo->BlockNum, ReqBlocks);
+  Seed      = BLK_BENCH_RANDOM_SEED;
+
+  Result->TotalNs = 0;
+  Result->MinNs   = MAX_UINT64;
+  Result->MaxNs   = 0;
+  ZeroMem (Result->Hist, sizeof (Result->Hist));
+
+  for (Index = 0; Index < Result->Count; Index++) {
+    if (Random) {
+      Lba = MultU64x32 (ModU64x32 (BlkBenchRandom (&Seed), (UINT32)MIN (Slots, MAX_UINT32)), ReqBlocks);
+    } else {
+      Lba = MultU64x32 (ModU64x32 (Index, (UINT32)MIN (Slots, MAX_UINT32)), ReqBlocks);
+    }
+
+    Start     = GetPerformanceCounter ();
+    Status    = MediaReadBlocks (HwPart, Lba, Result->ReqSize, Buffer);
+    LatencyNs = GetTimeInNanoSecond (GetPerformanceCounter () - Start);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    Result->TotalNs += LatencyNs;
+    Result->MinNs    = MIN (Result->MinNs, LatencyNs);
+    Result->MaxNs    = MAX (Result->MaxNs, LatencyNs);
+    Result->Hist[BlkBenchHistBucket (LatencyNs)]++;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Print one result record.
+
+  @param[in]  DeviceType      Media device type
+  @param[in]  DeviceInstance  Media device instance
+  @param[in]  HwPart          HW partition
+  @param[in]  BlockSize       Device block size
+  @param[in]  Random          TRUE for random LBAs, FALSE for sequential LBAs
+  @param[in]  Result          Benchmark statistics
+
+**/
+STATIC
+VOID
+BlkBenchPrintResult (
+  IN OS_BOOT_MEDIUM_TYPE  DeviceType,
+  IN UINT8                DeviceInstance,
+  IN UINT32               HwPart,
+  IN UINT32               BlockSize,
+  IN BOOLEAN              Random,
+  IN BLK_BENCH_RESULT    *Result
+  )
+{
+  UINT64  Bytes;
+  UINT32  KBps;
+  UINT32  Index;
+
+  Bytes = MultU64x32 (Result->ReqSize, Result->Count);
+  KBps  = 0;
+  if (Result->TotalNs != 0) {
+    KBps = (UINT32)DivU64x64Remainder (MultU64x32 (Bytes, 1000000000 / SIZE_1KB), Result->TotalNs, NULL);
+  }
+
+  ShellPrint (L"res,%a,%d,%d,%d,%a,1,%d,%d,%ld,%ld,%d,%ld,%ld,%ld",
+    GetBootDeviceNameString (DeviceType), DeviceInstance, HwPart, BlockSize,
+    Random ? "rand" : "seq", Result->ReqSize, Result->Count, Bytes,
+    DivU64x32 (Result->TotalNs, 1000), KBps,
+    DivU64x32 (Result->MinNs, 1000),
+    DivU64x32 (DivU64x32 (Result->TotalNs, Result->Count), 1000),
+    DivU64x32 (Result->MaxNs, 1000));
+  for (Index = 0; Index < BLK_BENCH_HIST_BUCKETS; Index++) {
+    ShellPrint (L",%d", Result->Hist[Index]);
+  }
+  ShellPrint (L"\n");
+}
+
+/**
+  Print the fixed per-request cost and the streaming rate for a pattern.
+
+  The average latency of the smallest and the largest request size are used
+  as two points of a line. Its intercept is the per-request overhead spent
+  in command setup and completion, its slope is the data transfer rate.
+
+  @param[in]  DeviceType      Media device type
+  @param[in]  DeviceInstance  Media device instance
+  @param[in]  HwPart          HW partition
+  @param[in]  Random          TRUE for random LBAs, FALSE for sequential LBAs
+  @param[in]  First           Result of the smallest request size
+  @param[in]  Last            Result of the largest request size
+
+**/
+STATIC
+VOID
+BlkBenchPrintFit (
+  IN OS_BOOT_MEDIUM_TYPE  DeviceType,
+  IN UINT8                DeviceInstance,
+  IN UINT32               HwPart,
+  IN BOOLEAN              Random,
+  IN BLK_BENCH_RESULT    *First,
+  IN BLK_BENCH_RESULT    *Last
+  )
+{
+  UINT64  FirstNs;
+  UINT64  LastNs;
+  UINT64  XferNs;
+  UINT64  OverheadNs;
+  UINT32  KBps;
+
+  if ((First == Last) || (First->Count == 0) || (Last->Count == 0)) {
+    return;
+  }
+
+  FirstNs = DivU64x32 (First->TotalNs, First->Count);
+  LastNs  = DivU64x32 (Last->TotalNs, Last->Count);
+  if (LastNs <= FirstNs) {
+    return;
+  }
+
+  //
+  // Transfer time for the smallest request, scaled from the slope
+  //
+  XferNs     = DivU64x32 (MultU64x32 (LastNs - FirstNs, First->ReqSize), Last->ReqSize - First->ReqSize);
+  OverheadNs = (FirstNs > XferNs) ? (FirstNs - XferNs) : 0;
+  KBps       = (UINT32)DivU64x64Remainder (MultU64x32 ((UINT64)(Last->ReqSize - First->ReqSize), 1000000000 / SIZE_1KB),
+                                           LastNs - FirstNs, NULL);
+
+  ShellPrint (L"fit,%a,%d,%d,%a,%ld,%d\n",
+    GetBootDeviceNameString (DeviceType), DeviceInstance, HwPart,
+    Random ? "rand" : "seq", DivU64x32 (OverheadNs, 1000), KBps);
+}
+
+/**
+  Benchmark one media device.
+
+  @param[in]  DeviceType      Media device type
+  @param[in]  DeviceInstance  Media device instance
+  @param[in]  HwPart          HW partition
+  @param[in]  Count           Number of requests per request size
+  @param[in]  Buffer          Read buffer of BLK_BENCH_MAX_REQ_SIZE bytes
+
+  @retval EFI_SUCCESS         Device benchmarked
+  @retval Others              Device could not be initialized or read
+
+**/
+STATIC
+EFI_STATUS
+BlkBenchDevice (
+  IN OS_BOOT_MEDIUM_TYPE  DeviceType,
+  IN UINT8                DeviceInstance,
+  IN UINT32               HwPart,
+  IN UINT32               Count,
+  IN VOID                *Buffer
+  )
+{
+  EFI_STATUS          Status;
+  UINTN               BaseAddress;
+  DEVICE_BLOCK_INFO   BlockInfo;
+  BLK_BENCH_RESULT    Result[ARRAY_SIZE (mBlkBenchReqSize)];
+  UINT32              ResultCount;
+  UINT32              ReqSize;
+  UINT32              Index;
+  UINT32              Pattern;
+
+  BaseAddress = GetDeviceAddr (DeviceType, DeviceInstance);
+  if (BaseAddress == 0) {
+    return EFI_NOT_FOUND;
+  } else if (!(BaseAddress & 0xFF000000)) {
+    BaseAddress = TO_MM_PCI_ADDRESS (BaseAddress);
+  }
+
+  Status = MediaSetInterfaceType (DeviceType);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = MediaInitialize (BaseAddress, DevInitAll);
+  if (!EFI_ERROR (Status)) {
+    ZeroMem (&BlockInfo, sizeof (BlockInfo));
+    Status = MediaGetMediaInfo (HwPart, &BlockInfo);
+  }
+  if (!EFI_ERROR (Status) && ((BlockInfo.BlockSize == 0) || (BlockInfo.BlockNum == 0) ||
+      (BlockInfo.BlockSize > BLK_BENCH_MAX_REQ_SIZE))) {
+    Status = EFI_UNSUPPORTED;
+  }
+
+  for (Pattern = 0; (Pattern < 2) && !EFI_ERROR (Status); Pattern++) {
+    ResultCount = 0;
+    for (Index = 0; Index < ARRAY_SIZE (mBlkBenchReqSize); Index++) {
+      ReqSize = ALIGN_VALUE (MAX (mBlkBenchReqSize[Index], BlockInfo.BlockSize), BlockInfo.BlockSize);
+      if ((ReqSize > BLK_BENCH_MAX_REQ_SIZE) || (DivU64x32 (BlockInfo.BlockNum, ReqSize / BlockInfo.BlockSize) == 0)) {
+        break;
+      }
+      if ((ResultCount > 0) && (Result[ResultCount - 1].ReqSize == ReqSize)) {
+        continue;
+      }
+
+      Result[ResultCount].ReqSize = ReqSize;
+      Result[ResultCount].Count   = Count;
+      Status = BlkBenchRun (HwPart, &BlockInfo, (BOOLEAN)(Pattern != 0), Buffer, &Result[ResultCount]);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+      BlkBenchPrintResult (DeviceType, DeviceInstance, HwPart, BlockInfo.BlockSize,
+        (BOOLEAN)(Pattern != 0), &Result[ResultCount]);
+      ResultCount++;
+    }
+    if (ResultCount > 0) {
+      BlkBenchPrintFit (DeviceType, DeviceInstance, HwPart, (BOOLEAN)(Pattern != 0),
+        &Result[0], &Result[ResultCount - 1]);
+    }
+  }
+
+  // If USB keyboard console is used, don't DeInit USB yet.
+  if (!((DeviceType == OsBootDeviceUsb) &&
+      ((PcdGet32 (PcdConsoleInDeviceMask) & ConsoleInUsbKeyboard) != 0))) {
+    MediaInitialize (0, DevDeinit);
+  }
+
+  return Status;
+}
+
+/**
+  Benchmark block device read performance
+
+  @param[in]  Shell        shell instance
+  @param[in]  Argc         number of command line arguments
+  @param[in]  Argv         command line arguments
+
+  @retval EFI_SUCCESS
+
+**/
+EFI_STATUS
+EFIAPI
+ShellCommandBlkBenchFunc (
+  IN SHELL  *Shell,
+  IN UINTN   Argc,
+  IN CHAR16 *Argv[]
+  )
+{
+  EFI_STATUS          Status;
+  PLT_DEVICE_TABLE   *DeviceTable;
+  OS_BOOT_MEDIUM_TYPE DeviceType;
+  UINT8               DeviceInstance;
+  UINT32              HwPart;
+  UINT32              Count;
+  CHAR16             *String;
+  UINTN               Result;
+  UINT16              Index;
+  VOID               *Buffer;
+
+  DeviceType     = OsBootDeviceMax;
+  DeviceInstance = 0;
+  if ((Argc > 1) && (StrCmp (Argv[1], L"all") != 0)) {
+    Status = StrHexToUintnS (Argv[1], &String, &Result);
+    if (EFI_ERROR (Status) || (Result >= OsBootDeviceMax)) {
+      goto Usage;
+    }
+    DeviceType = (OS_BOOT_MEDIUM_TYPE)Result;
+
+    Result = 0;
+    if (String[0] == L':') {
+      String++;
+      Status = StrHexToUintnS (String, NULL, &Result);
+      if (EFI_ERROR (Status)) {
+        goto Usage;
+      }
+    }
+    DeviceInstance = (UINT8)Result;
+  }
+  HwPart = (Argc < 3) ? 0 : (UINT32)StrHexToUintn (Argv[2]);
+  Count  = (Argc < 4) ? BLK_BENCH_DEF_REQ_COUNT : (UINT32)StrDecimalToUintn (Argv[3]);
+  if (Count == 0) {
+    goto Usage;
+  }
+
+  DeviceTable = (PLT_DEVICE_TABLE *)GetDeviceTable ();
+  if (DeviceTable == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  Buffer = AllocatePages (EFI_SIZE_TO_PAGES (BLK_BENCH_MAX_REQ_SIZE));
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Latencies are in microseconds and rates in KB/s. Queue depth is always 1
+  // since MediaAccessLib reads are synchronous.
+  //
+  ShellPrint (L"hdr,dev,inst,hwpart,blksz,pattern,qd,reqsz,count,bytes,total_us,kbps,min_us,avg_us,max_us");
+  for (Index = 0; Index < BLK_BENCH_HIST_BUCKETS; Index++) {
+    ShellPrint (L",hist%d", Index);
+  }
+  ShellPrint (L"\n");
+  ShellPrint (L"hdr,dev,inst,hwpart,pattern,overhead_us,xfer_kbps\n");
+
+  for (Index = 0; Index < DeviceTable->DeviceNumber; Index++) {
+    if (DeviceType == OsBootDeviceMax) {
+      if ((DeviceTable->Device[Index].Type >= OsBootDeviceMax) ||
+          (DeviceTable->Device[Index].Type == OsBootDeviceSpi) ||
+          (DeviceTable->Device[Index].Type == OsBootDeviceMemory)) {
+        continue;
+      }
+    } else if ((DeviceTable->Device[Index].Type != DeviceType) ||
+               (DeviceTable->Device[Index].Instance != DeviceInstance)) {
+      continue;
+    }
+
+    Status = BlkBenchDevice ((OS_BOOT_MEDIUM_TYPE)DeviceTable->Device[Index].Type,
+      DeviceTable->Device[Index].Instance, HwPart, Count, Buffer);
+    if (EFI_ERROR (Status)) {
+      ShellPrint (L"err,%a,%d,%d,%r\n",
+        GetBootDeviceNameString ((OS_BOOT_MEDIUM_TYPE)DeviceTable->Device[Index].Type),
+        DeviceTable->Device[Index].Instance, HwPart, Status);
+    }
+  }
+
+  FreePages (Buffer, EFI_SIZE_TO_PAGES (BLK_BENCH_MAX_REQ_SIZE));
+  return EFI_SUCCESS;
+
+Usage:
+  ShellPrint (L"Usage: %s [all | DevType[:DevInstance]] [HwPart] [Count]\n", Argv[0]);
+  ShellPrint (L"\nRead requests from %d bytes up to %d bytes are timed sequentially and at\n",
+    mBlkBenchReqSize[0], BLK_BENCH_MAX_REQ_SIZE);
+  ShellPrint (L"random LBAs. Output is comma separated. The media device is de-initialized\n");
+  ShellPrint (L"afterwards, run 'fs init' again to access a file system on it.\n");
+  ShellPrint (L"Count - Number of requests per request size (default %d)\n", BLK_BENCH_DEF_REQ_COUNT);
+
+  return EFI_ABORTED;
+}
@@ -6,6 +6,14 @@
 **/
 
 #include <Library/BaseLib.h>
+#include <Library/IoLib.h>
+#include <Library/PcdLib.h>
+#include <Register/Intel/Cpuid.h>
+
+#define ACPI_PM_TIMER_FREQ_HZ          3579545
+#define ACPI_PM_TIMER_MASK             (BIT24 - 1)
+#define CALIBRATE_PM_TIMER_TICKS       (ACPI_PM_TIMER_FREQ_HZ / 100)
+#define CALIBRATE_MAX_IDLE_READS       1000
 
 /**
   Read current timestamp.
@@ -22,9 +30,104 @@ ReadTimeStamp (
   return AsmReadTsc();
 }
 
+/**
+  Get timestamp frequency from CPUID leaf 0x15, or leaf 0x16 if the
+  crystal clock frequency is not enumerated.
+
+  @return   Timestamp frequency in KHZ, or 0 if not enumerated.
+
+**/
+STATIC
+UINT32
+GetCpuidTimeStampFrequency (
+  VOID
+  )
+{
+  UINT32                           MaxLeaf;
+  UINT32                           Denominator;
+  UINT32                           Numerator;
+  UINT32                           CrystalHz;
+  CPUID_PROCESSOR_FREQUENCY_EAX    FreqEax;
+
+  AsmCpuid (CPUID_SIGNATURE, &MaxLeaf, NULL, NULL, NULL);
+  if (MaxLeaf < CPUID_TIME_STAMP_COUNTER) {
+    return 0;
+  }
+
+  AsmCpuid (CPUID_TIME_STAMP_COUNTER, &Denominator, &Numerator, &CrystalHz, NULL);
+  if ((Denominator == 0) || (Numerator == 0)) {
+    return 0;
+  }
+
+  if (CrystalHz != 0) {
+    return (UINT32)DivU64x32 (MultU64x32 (CrystalHz, Numerator), Denominator * 1000);
+  }
+
+  // Crystal clock is not enumerated, TSC runs at the processor base frequency
+  if (MaxLeaf >= CPUID_PROCESSOR_FREQUENCY) {
+    AsmCpuid (CPUID_PROCESSOR_FREQUENCY, &FreqEax.Uint32, NULL, NULL, NULL);
+    return FreqEax.Bits.ProcessorBaseFrequency * 1000;
+  }
+
+  return 0;
+}
+
+/**
+  Calibrate timestamp frequency against the ACPI PM timer.
+
+  @return   Timestamp frequency in KHZ, or 0 if the PM timer is not running.
+
+**/
+STATIC
+UINT32
+CalibrateTimeStampFrequency (
+  VOID
+  )
+{
+  UINT16    PmTimerBase;
+  UINT32    StartTick;
+  UINT32    Tick;
+  UINT32    Elapsed;
+  UINT32    IdleReads;
+  UINT64    StartTsc;
+  UINT64    EndTsc;
+
+  PmTimerBase = PcdGet16 (PcdAcpiPmTimerBase);
+  if (PmTimerBase == 0) {
+    return 0;
+  }
+
+  //
+  // Align to a tick edge. The PM timer is not decoded yet on some platforms
+  // in early stages, so give up if it does not move.
+  //
+  StartTick = IoRead32 (PmTimerBase) & ACPI_PM_TIMER_MASK;
+  IdleReads = 0;
+  do {
+    Tick = IoRead32 (PmTimerBase) & ACPI_PM_TIMER_MASK;
+    if (++IdleReads > CALIBRATE_MAX_IDLE_READS) {
+      return 0;
+    }
+  } while (Tick == StartTick);
+
+  StartTick = Tick;
+  StartTsc  = AsmReadTsc ();
+  do {
+    Elapsed = ((IoRead32 (PmTimerBase) & ACPI_PM_TIMER_MASK) - StartTick) & ACPI_PM_TIMER_MASK;
+  } while (Elapsed < CALIBRATE_PM_TIMER_TICKS);
+  EndTsc    = AsmReadTsc ();
+
+  return (UINT32)DivU64x32 (MultU64x32 (EndTsc - StartTsc, ACPI_PM_TIMER_FREQ_HZ), Elapsed * 1000);
+}
+
 /**
   Get timestamp frequency in KHZ.
 
+  The frequency is enumerated through CPUID leaf 0x15/0x16 first, then from
+  the maximum non-turbo ratio in MSR_PLATFORM_INFO with a 100MHz bus clock.
+  If neither is available (e.g. QEMU), it is calibrated against the ACPI PM
+  timer for 10ms.
+
   @return   Timestamp frequency in KHZ.
 
 **/
@@ -34,13 +137,25 @@ GetTimeStampFrequency (
   VOID
   )
 {
+  UINT32 FreqKhz;
   UINT8  Ratio;
 
+  FreqKhz = GetCpuidTimeStampFrequency ();
+  if (FreqKhz != 0) {
+    return FreqKhz;
+  }
+
   Ratio = (UINT8)((UINT32)AsmReadMsr64 (0xCE) >> 8);
-  if (Ratio == 0) {
-    // This might be QEMU case
-    Ratio = 8;
+  if (Ratio != 0) {
+    // Ratio * 100000
+    return (UINT32)(Ratio * 100000);
   }
-  // Ratio * 100000
-  return (UINT32)(Ratio * 100000);
+
+  FreqKhz = CalibrateTimeStampFrequency ();
+  if (FreqKhz != 0) {
+    return FreqKhz;
+  }
+
+  // PM timer is not available yet, assume the legacy default ratio
+  return 8 * 100000;
 }
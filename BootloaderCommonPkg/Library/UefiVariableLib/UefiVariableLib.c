@@ -767,6 +767,40 @@ GetVariableNameOrData (
   CopyMem (Buffer, NameOrData, Size);
 }
 
+/**
+  Calculate the index hash for a variable name and vendor GUID.
+
+  @param  VariableName  Pointer to the variable name.
+  @param  NameSize      Variable name size in bytes.
+  @param  VendorGuid    Pointer to the vendor GUID.
+
+  @return Non-zero 16 bit hash value.
+
+**/
+UINT16
+GetVariableIndexHash (
+  IN CONST CHAR16                     *VariableName,
+  IN UINTN                             NameSize,
+  IN CONST EFI_GUID                   *VendorGuid
+  )
+{
+  CONST UINT8   *Ptr;
+  UINT32         Hash;
+  UINTN          Index;
+
+  //
+  // FNV-1a over the name bytes, seeded with the first GUID dword
+  //
+  Hash = 0x811C9DC5 ^ ReadUnaligned32 ((CONST UINT32 *) VendorGuid);
+  Ptr  = (CONST UINT8 *) VariableName;
+  for (Index = 0; Index < NameSize; Index++) {
+    Hash = (Hash ^ Ptr[Index]) * 0x01000193;
+  }
+
+  Hash = (Hash >> 16) ^ (Hash & 0xFFFF);
+  return (Hash == 0) ? 1 : (UINT16) Hash;
+}
+
 /**
   Find the variable in the specified variable store.
 
@@ -798,6 +832,7 @@ FindVariableEx (
   UEFI_VARIABLE_STORE_HEADER   *VariableStoreHeader;
   UEFI_VARIABLE_INDEX_TABLE    *IndexTable;
   UEFI_VARIABLE_HEADER         *VariableHeader;
+  UINT16                        Hash;
 
   VariableStoreHeader = StoreInfo->VariableStoreHeader;
 
@@ -825,6 +860,11 @@ FindVariableEx (
   MaxIndex   = NULL;
   VariableHeader = NULL;
 
+  Hash = 0;
+  if (VariableName[0] != 0) {
+    Hash = GetVariableIndexHash (VariableName, StrSize (VariableName), VendorGuid);
+  }
+
   if (IndexTable != NULL) {
     //
     // traverse the variable index table to look for varible.
@@ -834,6 +874,12 @@ FindVariableEx (
       ASSERT (Index < sizeof (IndexTable->Index) / sizeof (IndexTable->Index[0]));
       Offset   += IndexTable->Index[Index];
       MaxIndex  = (UEFI_VARIABLE_HEADER *) ((UINT8 *) IndexTable->StartPtr + Offset);
+      if ((Hash != 0) && (IndexTable->NameHash[Index] != 0) && (IndexTable->NameHash[Index] != Hash)) {
+        //
+        // Skip NV storage access for variables that cannot match
+        //
+        continue;
+      }
       GetVariableHeader (StoreInfo, MaxIndex, &VariableHeader);
       if (CompareWithValidVariable (StoreInfo, MaxIndex, VariableHeader, VariableName, VendorGuid, PtrTrack) == EFI_SUCCESS) {
         if (VariableHeader->State == (UEFI_VAR_IN_DELETED_TRANSITION & UEFI_VAR_ADDED)) {
@@ -858,6 +904,7 @@ FindVariableEx (
     // HOB exists but the variable cannot be found in HOB
     // If not found in HOB, then let's start from the MaxIndex we've found.
     //
+    GetVariableHeader (StoreInfo, MaxIndex, &VariableHeader);
     Variable     = GetNextVariablePtr (StoreInfo, MaxIndex, VariableHeader);
     LastVariable = MaxIndex;
   } else {
@@ -887,6 +934,14 @@ FindVariableEx (
           //
           StopRecord = TRUE;
         } else {
+          IndexTable->NameHash[IndexTable->Length] = 0;
+          if (StoreInfo->FtwLastWriteData == NULL) {
+            IndexTable->NameHash[IndexTable->Length] = GetVariableIndexHash (
+                                                         GetVariableNamePtr (Variable, StoreInfo->AuthFlag),
+                                                         NameSizeOfVariable (VariableHeader, StoreInfo->AuthFlag),
+                                                         GetVendorGuidPtr (VariableHeader, StoreInfo->AuthFlag)
+                                                         );
+          }
           IndexTable->Index[IndexTable->Length++] = (UINT16) Offset;
           LastVariable = Variable;
         }
@@ -11,6 +11,21 @@
 
 #define MSG_UFS_DP                0x19
 
+//
+// Reads are split into chunks, and up to UFS_MAX_QUEUED_READS chunks are kept
+// in flight in the transfer request list.
+//
+#define UFS_READ_CHUNK_SIZE       SIZE_64KB
+#define UFS_MAX_QUEUED_READS      8
+
+typedef struct {
+  UFS_SCSI_REQUEST_PACKET   Packet;
+  UINT8                     Cdb[UFS_SCSI_OP_LENGTH_SIXTEEN];
+  VOID                      *BufferMap;
+  UINT8                     Slot;
+  BOOLEAN                   Busy;
+} UFS_QUEUED_READ;
+
 //
 // Template for UFS HC Peim Private Data.
 //
@@ -107,7 +122,8 @@ UFS_PEIM_HC_PRIVATE_DATA   gUfsHcTemplate = {
     },
     0x0000,                           // By default exposing all Luns.
     0x0
-  }
+  },
+  0                               // SlotInUse
 };
 
 UFS_PEIM_HC_PRIVATE_DATA         *gPrivate = NULL;
@@ -389,68 +405,6 @@ UfsReadCapacity16 (
   return Status;
 }
 
-/**
-  Execute READ (10) SCSI command on a specific UFS device.
-
-  @param[in]  Private              A pointer to UFS_PEIM_HC_PRIVATE_DATA data structure.
-  @param[in]  Lun                  The lun on which the SCSI cmd executed.
-  @param[in]  StartLba             The start LBA.
-  @param[in]  SectorNum            The sector number to be read.
-  @param[out] DataBuffer           A pointer to data buffer.
-  @param[out] DataLength           The length of output data.
-  @param[out] SenseData            A pointer to output sense data.
-  @param[out] SenseDataLength      The length of output sense data.
-
-  @retval EFI_SUCCESS              The command executed successfully.
-  @retval EFI_DEVICE_ERROR         A device error occurred while attempting to send SCSI Request Packet.
-  @retval EFI_TIMEOUT              A timeout occurred while waiting for the SCSI Request Packet to execute.
-
-**/
-EFI_STATUS
-UfsRead10 (
-  IN     UFS_PEIM_HC_PRIVATE_DATA     *Private,
-  IN     UINTN                        Lun,
-  IN     UINTN                        StartLba,
-  IN     UINT32                       SectorNum,
-  OUT VOID                         *DataBuffer,
-  OUT UINT32                       *DataLength,
-  OUT VOID                         *SenseData,  OPTIONAL
-  OUT UINT8                        *SenseDataLength
-  )
-{
-  UFS_SCSI_REQUEST_PACKET             Packet;
-  UINT8                               Cdb[UFS_SCSI_OP_LENGTH_TEN];
-  EFI_STATUS                          Status;
-
-  ZeroMem (&Packet, sizeof (UFS_SCSI_REQUEST_PACKET));
-  ZeroMem (Cdb, sizeof (Cdb));
-
-  Cdb[0] = EFI_SCSI_OP_READ10;
-  WriteUnaligned32 ((UINT32 *)&Cdb[2], SwapBytes32 ((UINT32) StartLba));
-  WriteUnaligned16 ((UINT16 *)&Cdb[7], SwapBytes16 ((UINT16) SectorNum));
-
-  Packet.Timeout          = UFS_TIMEOUT;
-  Packet.Cdb              = Cdb;
-  Packet.CdbLength        = sizeof (Cdb);
-  Packet.InDataBuffer     = DataBuffer;
-  Packet.InTransferLength = *DataLength;
-  Packet.DataDirection    = UfsDataIn;
-  Packet.SenseData        = SenseData;
-  Packet.SenseDataLength  = *SenseDataLength;
-
-  Status = UfsExecScsiCmds (Private, (UINT8)Lun, &Packet);
-
-  if (*SenseDataLength != 0) {
-    *SenseDataLength = Packet.SenseDataLength;
-  }
-
-  if (!EFI_ERROR (Status)) {
-    *DataLength = Packet.InTransferLength;
-  }
-
-  return Status;
-}
-
 /**
   Execute WRITE (10) SCSI command on a specific UFS device.
 
@@ -513,68 +467,6 @@ UfsWrite10 (
   return Status;
 }
 
-/**
-  Execute READ (16) SCSI command on a specific UFS device.
-
-  @param[in]  Private              A pointer to UFS_PEIM_HC_PRIVATE_DATA data structure.
-  @param[in]  Lun                  The lun on which the SCSI cmd executed.
-  @param[in]  StartLba             The start LBA.
-  @param[in]  SectorNum            The sector number to be read.
-  @param[out] DataBuffer           A pointer to data buffer.
-  @param[out] DataLength           The length of output data.
-  @param[out] SenseData            A pointer to output sense data.
-  @param[out] SenseDataLength      The length of output sense data.
-
-  @retval EFI_SUCCESS              The command executed successfully.
-  @retval EFI_DEVICE_ERROR         A device error occurred while attempting to send SCSI Request Packet.
-  @retval EFI_TIMEOUT              A timeout occurred while waiting for the SCSI Request Packet to execute.
-
-**/
-EFI_STATUS
-UfsRead16 (
-  IN     UFS_PEIM_HC_PRIVATE_DATA     *Private,
-  IN     UINTN                        Lun,
-  IN     UINTN                        StartLba,
-  IN     UINT32                       SectorNum,
-  OUT VOID                         *DataBuffer,
-  OUT UINT32                       *DataLength,
-  OUT VOID                         *SenseData,  OPTIONAL
-  OUT UINT8                        *SenseDataLength
-  )
-{
-  UFS_SCSI_REQUEST_PACKET             Packet;
-  UINT8                               Cdb[UFS_SCSI_OP_LENGTH_SIXTEEN];
-  EFI_STATUS                          Status;
-
-  ZeroMem (&Packet, sizeof (UFS_SCSI_REQUEST_PACKET));
-  ZeroMem (Cdb, sizeof (Cdb));
-
-  Cdb[0] = EFI_SCSI_OP_READ16;
-  WriteUnaligned64 ((UINT64 *)&Cdb[2], SwapBytes64 (StartLba));
-  WriteUnaligned32 ((UINT32 *)&Cdb[10], SwapBytes32 (SectorNum));
-
-  Packet.Timeout          = UFS_TIMEOUT;
-  Packet.Cdb              = Cdb;
-  Packet.CdbLength        = sizeof (Cdb);
-  Packet.InDataBuffer     = DataBuffer;
-  Packet.InTransferLength = *DataLength;
-  Packet.DataDirection    = UfsDataIn;
-  Packet.SenseData        = SenseData;
-  Packet.SenseDataLength  = *SenseDataLength;
-
-  Status = UfsExecScsiCmds (Private, (UINT8)Lun, &Packet);
-
-  if (*SenseDataLength != 0) {
-    *SenseDataLength = Packet.SenseDataLength;
-  }
-
-  if (!EFI_ERROR (Status)) {
-    *DataLength = Packet.InTransferLength;
-  }
-
-  return Status;
-}
-
 /**
   Execute WRITE (16) SCSI command on a specific UFS device.
 
@@ -886,6 +778,52 @@ Done:
   return Status;
 }
 
+/**
+  Prepare a READ (10) or READ (16) request for a chunk of a queued read.
+
+  @param[in]  Private       A pointer to UFS_PEIM_HC_PRIVATE_DATA data structure.
+  @param[in]  DeviceIndex   The lun on which the SCSI cmd executed.
+  @param[in]  Lba           The start LBA of the chunk.
+  @param[in]  Buffer        A pointer to the destination buffer of the chunk.
+  @param[in]  Length        The size of the chunk in bytes.
+  @param[out] Request       The request to prepare.
+
+**/
+STATIC
+VOID
+UfsInitQueuedRead (
+  IN  UFS_PEIM_HC_PRIVATE_DATA       *Private,
+  IN  UINTN                          DeviceIndex,
+  IN  EFI_LBA                        Lba,
+  IN  VOID                           *Buffer,
+  IN  UINT32                         Length,
+  OUT UFS_QUEUED_READ                *Request
+  )
+{
+  UINT32                             SectorNum;
+
+  ZeroMem (Request, sizeof (UFS_QUEUED_READ));
+  SectorNum = Length / Private->Media[DeviceIndex].BlockSize;
+
+  if (Private->Media[DeviceIndex].LastBlock < 0xfffffffful) {
+    Request->Cdb[0] = EFI_SCSI_OP_READ10;
+    WriteUnaligned32 ((UINT32 *)&Request->Cdb[2], SwapBytes32 ((UINT32) Lba));
+    WriteUnaligned16 ((UINT16 *)&Request->Cdb[7], SwapBytes16 ((UINT16) SectorNum));
+    Request->Packet.CdbLength = UFS_SCSI_OP_LENGTH_TEN;
+  } else {
+    Request->Cdb[0] = EFI_SCSI_OP_READ16;
+    WriteUnaligned64 ((UINT64 *)&Request->Cdb[2], SwapBytes64 (Lba));
+    WriteUnaligned32 ((UINT32 *)&Request->Cdb[10], SwapBytes32 (SectorNum));
+    Request->Packet.CdbLength = UFS_SCSI_OP_LENGTH_SIXTEEN;
+  }
+
+  Request->Packet.Timeout          = UFS_TIMEOUT;
+  Request->Packet.Cdb              = Request->Cdb;
+  Request->Packet.InDataBuffer     = Buffer;
+  Request->Packet.InTransferLength = Length;
+  Request->Packet.DataDirection    = UfsDataIn;
+}
+
 /**
   Reads the requested number of blocks from the specified block device.
 
@@ -927,11 +865,20 @@ UfsReadBlocksInternal (
 {
   EFI_STATUS                         Status;
   UINTN                              BlockSize;
-  UINTN                              NumberOfBlocks;
   UFS_PEIM_HC_PRIVATE_DATA           *Private;
   EFI_SCSI_SENSE_DATA                SenseData;
   UINT8                              SenseDataLength;
   BOOLEAN                            NeedRetry;
+  UFS_QUEUED_READ                    Request[UFS_MAX_QUEUED_READS];
+  EFI_STATUS                         ReqStatus;
+  UINTN                              MaxQueued;
+  UINTN                              Queued;
+  UINTN                              Index;
+  UINTN                              Offset;
+  UINT32                             Length;
+  UINT32                             Doorbell;
+  UINT64                             Delay;
+  BOOLEAN                            Reaped;
 
   Private = UfsGetPrivateData();
   if (Private == NULL) {
@@ -966,15 +913,13 @@ UfsReadBlocksInternal (
   BlockSize = Private->Media[DeviceIndex].BlockSize;
 
   if (BufferSize % BlockSize != 0) {
-    Status = EFI_BAD_BUFFER_SIZE;
+    return EFI_BAD_BUFFER_SIZE;
   }
 
   if (StartLBA > Private->Media[DeviceIndex].LastBlock) {
-    Status = EFI_INVALID_PARAMETER;
+    return EFI_INVALID_PARAMETER;
   }
 
-  NumberOfBlocks = BufferSize / BlockSize;
-
   do {
     Status = UfsTestUnitReady (
                Private,
@@ -997,30 +942,81 @@ UfsReadBlocksInternal (
 
   } while (NeedRetry);
 
-  SenseDataLength = 0;
-  if (Private->Media[DeviceIndex].LastBlock < 0xfffffffful) {
-    Status = UfsRead10 (
-               Private,
-               DeviceIndex,
-               (UINT32)StartLBA,
-               (UINT32)NumberOfBlocks,
-               Buffer,
-               (UINT32 *)&BufferSize,
-               NULL,
-               &SenseDataLength
-               );
-  } else {
-    Status = UfsRead16 (
-               Private,
-               DeviceIndex,
-               (UINT32)StartLBA,
-               (UINT32)NumberOfBlocks,
-               Buffer,
-               (UINT32 *)&BufferSize,
-               NULL,
-               &SenseDataLength
-               );
+  //
+  // Keep several READ commands in flight so that the device can pipeline them.
+  // A request is complete once the host controller clears its doorbell bit.
+  //
+  ZeroMem (Request, sizeof (Request));
+  MaxQueued = MIN (Private->Nutrs, UFS_MAX_QUEUED_READS);
+  Queued    = 0;
+  Offset    = 0;
+  Delay     = DivU64x32 (UFS_TIMEOUT, 10) + 1;
+  Status    = EFI_SUCCESS;
+
+  while (((Offset < BufferSize) && !EFI_ERROR (Status)) || (Queued > 0)) {
+    for (Index = 0; (Index < MaxQueued) && (Offset < BufferSize) && !EFI_ERROR (Status); Index++) {
+      if (Request[Index].Busy) {
+        continue;
+      }
+      Length = (UINT32) MIN (BufferSize - Offset, UFS_READ_CHUNK_SIZE);
+      UfsInitQueuedRead (Private, DeviceIndex, StartLBA + Offset / BlockSize, (UINT8 *)Buffer + Offset, Length, &Request[Index]);
+      Status = UfsStartScsiCmd (Private, (UINT8)DeviceIndex, &Request[Index].Packet, &Request[Index].Slot, &Request[Index].BufferMap);
+      if ((Status == EFI_NOT_READY) && (Queued > 0)) {
+        //
+        // All slots are busy, queue the rest once some requests complete.
+        //
+        Status = EFI_SUCCESS;
+        break;
+      }
+      if (!EFI_ERROR (Status)) {
+        Request[Index].Busy = TRUE;
+        Queued++;
+        Offset += Length;
+      }
+    }
+
+    if (Queued == 0) {
+      continue;
+    }
+
+    Doorbell = MmioRead32 (Private->UfsHcBase + UFS_HC_UTRLDBR_OFFSET);
+    Reaped   = FALSE;
+    for (Index = 0; Index < MaxQueued; Index++) {
+      if (!Request[Index].Busy || ((Doorbell & (BIT0 << Request[Index].Slot)) != 0)) {
+        continue;
+      }
+      Length    = Request[Index].Packet.InTransferLength;
+      ReqStatus = UfsFinishScsiCmd (Private, &Request[Index].Packet, Request[Index].Slot, Request[Index].BufferMap, EFI_SUCCESS);
+      if (!EFI_ERROR (ReqStatus) && (Request[Index].Packet.InTransferLength != Length)) {
+        ReqStatus = EFI_DEVICE_ERROR;
+      }
+      if (!EFI_ERROR (Status)) {
+        Status = ReqStatus;
+      }
+      Request[Index].Busy = FALSE;
+      Queued--;
+      Reaped = TRUE;
+    }
+
+    if (Reaped) {
+      Delay = DivU64x32 (UFS_TIMEOUT, 10) + 1;
+    } else if (--Delay == 0) {
+      //
+      // Abort all the outstanding requests on timeout.
+      //
+      for (Index = 0; Index < MaxQueued; Index++) {
+        if (Request[Index].Busy) {
+          UfsFinishScsiCmd (Private, &Request[Index].Packet, Request[Index].Slot, Request[Index].BufferMap, EFI_TIMEOUT);
+          Request[Index].Busy = FALSE;
+        }
+      }
+      Queued = 0;
+      Status = EFI_TIMEOUT;
+    } else {
+      MicroSecondDelay (1);
+    }
   }
+
   return Status;
 }
 
@@ -1066,27 +1062,10 @@ UfsReadBlocks (
   )
 {
   EFI_STATUS                         Status;
-  UINT32                             ReadSize;
-  UINT32                             ReadBlockSize;
-  EFI_LBA                            LbaAddress;
-
-  Status     = EFI_SUCCESS;
-  ReadSize   = 0;
-  LbaAddress = StartLba;
-  while (ReadSize < BufferSize) {
-    if (ReadSize + SIZE_64KB > BufferSize) {
-      ReadBlockSize = (UINT32)BufferSize - ReadSize;
-    } else {
-      ReadBlockSize = SIZE_64KB;
-    }
 
-    Status = UfsReadBlocksInternal (DeviceIndex, LbaAddress, ReadBlockSize, (UINT8 *)Buffer + ReadSize);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_INFO, "    UfsReadBlocks_internal: Status = %r\n", Status));
-      break;
-    }
-    ReadSize   += ReadBlockSize;
-    LbaAddress += ReadBlockSize / SIZE_4KB;
+  Status = UfsReadBlocksInternal (DeviceIndex, StartLba, BufferSize, Buffer);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "    UfsReadBlocks_internal: Status = %r\n", Status));
   }
 
   return Status;
@@ -669,6 +669,7 @@ UfsCreateNopCommandDesc (
   @param[out] Slot          The available slot.
 
   @retval EFI_SUCCESS       The available slot was found successfully.
+  @retval EFI_NOT_READY     All slots are in use.
 
 **/
 EFI_STATUS
@@ -677,15 +678,24 @@ UfsFindAvailableSlotInTrl (
   OUT UINT8                        *Slot
   )
 {
+  UINT32        Doorbell;
+  UINT8         Index;
+
   ASSERT ((Private != NULL) && (Slot != NULL));
 
   //
-  // The simplest algo to always use slot 0.
-  // TODO: enhance it to support async transfer with multiple slot.
+  // A slot is available when the host controller has completed it and no
+  // queued request still owns its command descriptor.
   //
-  *Slot = 0;
+  Doorbell = MmioRead32 (Private->UfsHcBase + UFS_HC_UTRLDBR_OFFSET);
+  for (Index = 0; Index < Private->Nutrs; Index++) {
+    if (((Doorbell | Private->SlotInUse) & (BIT0 << Index)) == 0) {
+      *Slot = Index;
+      return EFI_SUCCESS;
+    }
+  }
 
-  return EFI_SUCCESS;
+  return EFI_NOT_READY;
 }
 
 
@@ -741,9 +751,11 @@ UfsStopExecCmd (
   Address = UfsHcBase + UFS_HC_UTRLDBR_OFFSET;
   Data    = MmioRead32 (Address);
   if ((Data & (BIT0 << Slot)) != 0) {
+    //
+    // Only the bits written as 0 are cleared, keep other slots running
+    //
     Address = UfsHcBase + UFS_HC_UTRLCLR_OFFSET;
-    Data    = MmioRead32 (Address);
-    MmioWrite32 (Address, (Data & ~ (BIT0 << Slot)));
+    MmioWrite32 (Address, ~ (BIT0 << Slot));
   }
 }
 
@@ -1095,75 +1107,100 @@ Exit:
 }
 
 /**
-  Sends a UFS-supported SCSI Request Packet to a UFS device that is attached to the UFS host controller.
+  Start a UFS-supported SCSI Request Packet in an available slot of the transfer request list.
 
-  @param[in]      Private       The pointer to the UFS_PEIM_HC_PRIVATE_DATA data structure.
-  @param[in]      Lun           The LUN of the UFS device to send the SCSI Request Packet.
-  @param[in, out] Packet        A pointer to the SCSI Request Packet to send to a specified Lun of the
-                                UFS device.
+  The caller must call UfsFinishScsiCmd () for the returned slot after the host controller
+  has completed it.
 
-  @retval EFI_SUCCESS           The SCSI Request Packet was sent by the host. For bi-directional
-                                commands, InTransferLength bytes were transferred from
-                                InDataBuffer. For write and bi-directional commands,
-                                OutTransferLength bytes were transferred by
-                                OutDataBuffer.
-  @retval EFI_DEVICE_ERROR      A device error occurred while attempting to send the SCSI Request
-                                Packet.
-  @retval EFI_OUT_OF_RESOURCES  The resource for transfer is not available.
-  @retval EFI_TIMEOUT           A timeout occurred while waiting for the SCSI Request Packet to execute.
+  @param[in]      Private         The pointer to the UFS_PEIM_HC_PRIVATE_DATA data structure.
+  @param[in]      Lun             The LUN of the UFS device to send the SCSI Request Packet.
+  @param[in, out] Packet          A pointer to the SCSI Request Packet to send to a specified Lun of the
+                                  UFS device.
+  @param[out]     Slot            The slot used by the request.
+  @param[out]     PacketBufferMap The mapping of the data buffer, to be passed to UfsFinishScsiCmd ().
+
+  @retval EFI_SUCCESS             The SCSI Request Packet was started.
+  @retval EFI_NOT_READY           All slots are in use.
+  @retval EFI_OUT_OF_RESOURCES    The resource for transfer is not available.
 
 **/
 EFI_STATUS
-EFIAPI
-UfsExecScsiCmds (
+UfsStartScsiCmd (
   IN     UFS_PEIM_HC_PRIVATE_DATA      *Private,
   IN     UINT8                         Lun,
-  IN OUT UFS_SCSI_REQUEST_PACKET       *Packet
+  IN OUT UFS_SCSI_REQUEST_PACKET       *Packet,
+  OUT    UINT8                         *Slot,
+  OUT    VOID                          **PacketBufferMap
   )
 {
   EFI_STATUS                           Status;
-  UINT8                                Slot;
   UTP_TRD                              *Trd;
-  UINTN                                Address;
-  UINT8                                *CmdDescBase;
-  UINT32                               CmdDescSize;
-  UTP_RESPONSE_UPIU                    *Response;
-  UINT16                               SenseDataLen;
-  UINT32                               ResTranCount;
-  VOID                                 *PacketBufferMap;
 
   //
   // Find out which slot of transfer request list is available.
   //
-  Status = UfsFindAvailableSlotInTrl (Private, &Slot);
+  Status = UfsFindAvailableSlotInTrl (Private, Slot);
   if (EFI_ERROR (Status)) {
     return Status;
   }
 
-  Trd = ((UTP_TRD *)Private->UtpTrlBase) + Slot;
-  PacketBufferMap = NULL;
+  Trd = ((UTP_TRD *)Private->UtpTrlBase) + *Slot;
+  *PacketBufferMap = NULL;
 
   //
   // Fill transfer request descriptor to this slot.
   //
-  Status = UfsCreateScsiCommandDesc (Private, Lun, Packet, Trd, &PacketBufferMap);
+  Status = UfsCreateScsiCommandDesc (Private, Lun, Packet, Trd, PacketBufferMap);
   if (EFI_ERROR (Status)) {
     return Status;
   }
 
-  CmdDescBase = (UINT8 *) (UINTN) (LShiftU64 ((UINT64)Trd->UcdBaU, 32) | LShiftU64 ((UINT64)Trd->UcdBa, 7));
-  CmdDescSize = Trd->PrdtO * sizeof (UINT32) + Trd->PrdtL * sizeof (UTP_TR_PRD);
-
   //
   // Start to execute the transfer request.
   //
-  UfsStartExecCmd (Private, Slot);
+  Private->SlotInUse |= (BIT0 << *Slot);
+  UfsStartExecCmd (Private, *Slot);
 
-  //
-  // Wait for the completion of the transfer request.
-  //
-  Address = Private->UfsHcBase + UFS_HC_UTRLDBR_OFFSET;
-  Status = UfsWaitMemSet (Address, BIT0 << Slot, 0, Packet->Timeout);
+  return EFI_SUCCESS;
+}
+
+/**
+  Complete a SCSI Request Packet started by UfsStartScsiCmd () and release its slot.
+
+  @param[in]      Private         The pointer to the UFS_PEIM_HC_PRIVATE_DATA data structure.
+  @param[in, out] Packet          A pointer to the SCSI Request Packet that was started.
+  @param[in]      Slot            The slot used by the request.
+  @param[in]      PacketBufferMap The mapping of the data buffer returned by UfsStartScsiCmd ().
+  @param[in]      ExecStatus      EFI_SUCCESS if the host controller has completed the slot,
+                                  or the error that occurred while waiting for it.
+
+  @retval EFI_SUCCESS             The SCSI Request Packet was executed successfully.
+  @retval EFI_DEVICE_ERROR        A device error occurred while executing the SCSI Request Packet.
+  @retval Others                  The error passed in ExecStatus.
+
+**/
+EFI_STATUS
+UfsFinishScsiCmd (
+  IN     UFS_PEIM_HC_PRIVATE_DATA      *Private,
+  IN OUT UFS_SCSI_REQUEST_PACKET       *Packet,
+  IN     UINT8                         Slot,
+  IN     VOID                          *PacketBufferMap,
+  IN     EFI_STATUS                    ExecStatus
+  )
+{
+  EFI_STATUS                           Status;
+  UTP_TRD                              *Trd;
+  UINT8                                *CmdDescBase;
+  UINT32                               CmdDescSize;
+  UTP_RESPONSE_UPIU                    *Response;
+  UINT16                               SenseDataLen;
+  UINT32                               ResTranCount;
+
+  Trd         = ((UTP_TRD *)Private->UtpTrlBase) + Slot;
+  CmdDescBase = (UINT8 *) (UINTN) (LShiftU64 ((UINT64)Trd->UcdBaU, 32) | LShiftU64 ((UINT64)Trd->UcdBa, 7));
+  CmdDescSize = Trd->PrdtO * sizeof (UINT32) + Trd->PrdtL * sizeof (UTP_TR_PRD);
+
+  Status = ExecStatus;
   if (EFI_ERROR (Status)) {
     goto Exit;
   }
@@ -1220,10 +1257,57 @@ Exit:
   }
   UfsStopExecCmd (Private, Slot);
   UfsFreeMem (Private->Pool, CmdDescBase, CmdDescSize);
+  Private->SlotInUse &= ~(BIT0 << Slot);
 
   return Status;
 }
 
+/**
+  Sends a UFS-supported SCSI Request Packet to a UFS device that is attached to the UFS host controller.
+
+  @param[in]      Private       The pointer to the UFS_PEIM_HC_PRIVATE_DATA data structure.
+  @param[in]      Lun           The LUN of the UFS device to send the SCSI Request Packet.
+  @param[in, out] Packet        A pointer to the SCSI Request Packet to send to a specified Lun of the
+                                UFS device.
+
+  @retval EFI_SUCCESS           The SCSI Request Packet was sent by the host. For bi-directional
+                                commands, InTransferLength bytes were transferred from
+                                InDataBuffer. For write and bi-directional commands,
+                                OutTransferLength bytes were transferred by
+                                OutDataBuffer.
+  @retval EFI_DEVICE_ERROR      A device error occurred while attempting to send the SCSI Request
+                                Packet.
+  @retval EFI_OUT_OF_RESOURCES  The resource for transfer is not available.
+  @retval EFI_TIMEOUT           A timeout occurred while waiting for the SCSI Request Packet to execute.
+
+**/
+EFI_STATUS
+EFIAPI
+UfsExecScsiCmds (
+  IN     UFS_PEIM_HC_PRIVATE_DATA      *Private,
+  IN     UINT8                         Lun,
+  IN OUT UFS_SCSI_REQUEST_PACKET       *Packet
+  )
+{
+  EFI_STATUS                           Status;
+  UINT8                                Slot;
+  UINTN                                Address;
+  VOID                                 *PacketBufferMap;
+
+  Status = UfsStartScsiCmd (Private, Lun, Packet, &Slot, &PacketBufferMap);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Wait for the completion of the transfer request.
+  //
+  Address = Private->UfsHcBase + UFS_HC_UTRLDBR_OFFSET;
+  Status = UfsWaitMemSet (Address, BIT0 << Slot, 0, Packet->Timeout);
+
+  return UfsFinishScsiCmd (Private, Packet, Slot, PacketBufferMap, Status);
+}
+
 
 /**
   Sent UIC DME_LINKSTARTUP command to start the link startup procedure.
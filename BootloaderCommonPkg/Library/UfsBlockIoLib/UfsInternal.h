@@ -144,6 +144,7 @@ typedef struct _UFS_PEIM_HC_PRIVATE_DATA {
   VOID                              *TmrlMapping;
 
   UFS_PEIM_EXPOSED_LUNS             Luns;
+  UINT32                            SlotInUse;
 } UFS_PEIM_HC_PRIVATE_DATA;
 
 #define UFS_TIMEOUT                 MultU64x32((UINT64)(3), 1000000)
@@ -197,6 +198,57 @@ UfsExecScsiCmds (
   IN OUT UFS_SCSI_REQUEST_PACKET       *Packet
   );
 
+/**
+  Start a UFS-supported SCSI Request Packet in an available slot of the transfer request list.
+
+  The caller must call UfsFinishScsiCmd () for the returned slot after the host controller
+  has completed it.
+
+  @param[in]      Private         The pointer to the UFS_PEIM_HC_PRIVATE_DATA data structure.
+  @param[in]      Lun             The LUN of the UFS device to send the SCSI Request Packet.
+  @param[in, out] Packet          A pointer to the SCSI Request Packet to send to a specified Lun of the
+                                  UFS device.
+  @param[out]     Slot            The slot used by the request.
+  @param[out]     PacketBufferMap The mapping of the data buffer, to be passed to UfsFinishScsiCmd ().
+
+  @retval EFI_SUCCESS             The SCSI Request Packet was started.
+  @retval EFI_NOT_READY           All slots are in use.
+  @retval EFI_OUT_OF_RESOURCES    The resource for transfer is not available.
+
+**/
+EFI_STATUS
+UfsStartScsiCmd (
+  IN     UFS_PEIM_HC_PRIVATE_DATA      *Private,
+  IN     UINT8                         Lun,
+  IN OUT UFS_SCSI_REQUEST_PACKET       *Packet,
+  OUT    UINT8                         *Slot,
+  OUT    VOID                          **PacketBufferMap
+  );
+
+/**
+  Complete a SCSI Request Packet started by UfsStartScsiCmd () and release its slot.
+
+  @param[in]      Private         The pointer to the UFS_PEIM_HC_PRIVATE_DATA data structure.
+  @param[in, out] Packet          A pointer to the SCSI Request Packet that was started.
+  @param[in]      Slot            The slot used by the request.
+  @param[in]      PacketBufferMap The mapping of the data buffer returned by UfsStartScsiCmd ().
+  @param[in]      ExecStatus      EFI_SUCCESS if the host controller has completed the slot,
+                                  or the error that occurred while waiting for it.
+
+  @retval EFI_SUCCESS             The SCSI Request Packet was executed successfully.
+  @retval EFI_DEVICE_ERROR        A device error occurred while executing the SCSI Request Packet.
+  @retval Others                  The error passed in ExecStatus.
+
+**/
+EFI_STATUS
+UfsFinishScsiCmd (
+  IN     UFS_PEIM_HC_PRIVATE_DATA      *Private,
+  IN OUT UFS_SCSI_REQUEST_PACKET       *Packet,
+  IN     UINT8                         Slot,
+  IN     VOID                          *PacketBufferMap,
+  IN     EFI_STATUS                    ExecStatus
+  );
+
 /**
   Initialize the UFS host controller.
 
@@ -181,7 +181,6 @@ BotDataPhase (
   UINT8           EndpointAddr;
   UINTN           Remain;
   UINTN           Increment;
-  UINT32          MaxPacketLen;
   UINT8           *BufferPtr;
   UINTN           TransferredSize;
 
@@ -192,22 +191,21 @@ BotDataPhase (
   TransferredSize = 0;
 
   //
-  // retrieve the the max packet length of the given endpoint
+  // retrieve the endpoint address of the given direction
   //
   if (Direction == EfiUsbDataIn) {
-    MaxPacketLen  = (PeiBotDev->BulkInEndpoint)->MaxPacketSize;
     EndpointAddr  = (PeiBotDev->BulkInEndpoint)->EndpointAddress;
   } else {
-    MaxPacketLen  = (PeiBotDev->BulkOutEndpoint)->MaxPacketSize;
     EndpointAddr  = (PeiBotDev->BulkOutEndpoint)->EndpointAddress;
   }
 
   while (Remain > 0) {
     //
-    // Using 15 packets to avoid Bitstuff error
+    // Issue the data phase as one bulk transfer, the host controller splits
+    // it into packets. This avoids a round trip per few packets.
     //
-    if (Remain > 16 * MaxPacketLen) {
-      Increment = 16 * MaxPacketLen;
+    if (Remain > USB_BOT_MAX_TRANSFER_SIZE) {
+      Increment = USB_BOT_MAX_TRANSFER_SIZE;
     } else {
       Increment = Remain;
     }
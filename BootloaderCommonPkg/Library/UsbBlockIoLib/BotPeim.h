@@ -58,6 +58,12 @@ typedef struct {
 #define CSWSIG  0x53425355
 #define CBWSIG  0x43425355
 
+//
+// Maximum data length of a single BOT command. 240 sectors of 512 bytes is
+// the largest size that is known to work with most USB mass storage devices.
+//
+#define USB_BOT_MAX_TRANSFER_SIZE  (240 * 512)
+
 /**
   Sends out ATAPI Inquiry Packet Command to the specified device. This command will
   return INQUIRY data of the device.
@@ -390,7 +390,7 @@ PeiUsbRead10 (
 
   BlockSize       = (UINT32) PeiBotDevice->Media.BlockSize;
 
-  MaxBlock        = (UINT16) (65535 / BlockSize);
+  MaxBlock        = (UINT16) (USB_BOT_MAX_TRANSFER_SIZE / BlockSize);
   BlocksRemaining = (UINT32) NumberOfBlocks;
 
   Status          = EFI_SUCCESS;
@@ -427,7 +427,7 @@ PeiUsbRead10 (
 
     ByteCount               = SectorCount * BlockSize;
 
-    TimeOut                 = (UINT16) (SectorCount * 2000);
+    TimeOut                 = (UINT16) MIN (SectorCount * 2000, MAX_UINT16);
 
     //
     // send command packet
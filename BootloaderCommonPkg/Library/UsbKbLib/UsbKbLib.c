@@ -345,7 +345,12 @@ UsbFindUsbKbDevice (
     UsbKbDevice->UsbIo               = UsbIoPpi;
     UsbKbDevice->InterfaceDescriptor = *InterfaceDesc;
     UsbKbDevice->EndpointDescriptor  = *EndpointDescriptor;
-    UsbKbDevice->TimeStampFreqKhz    = GetTimeStampFrequency ();
+    // Use the frequency measured by the bootloader and handed over in the
+    // performance data, it cannot be recalibrated reliably from here
+    UsbKbDevice->TimeStampFreqKhz    = GetPerfDataPtr ()->FreqKhz;
+    if (UsbKbDevice->TimeStampFreqKhz == 0) {
+      UsbKbDevice->TimeStampFreqKhz  = GetTimeStampFrequency ();
+    }
 
     Status = UsbSetProtocolRequest (
       UsbKbDevice->UsbIo,
@@ -645,7 +650,9 @@ KeyboardPoll (
     return FALSE;
   }
 
-  // Use interrupt transfer to get report
+  // Use interrupt transfer to get report. The host controller keeps the transfer
+  // queued on the endpoint and returns at once if no new report is available,
+  // so polling does not stall the caller for the endpoint interval.
   Char     = 0;
   DataSize = sizeof (KeyBuf);
 
@@ -852,6 +852,8 @@ ON_EXIT:
                                 transfer is allowed to complete.
                                 If Timeout is 0, then the caller must wait for the function
                                 to be completed until EFI_SUCCESS or EFI_DEVICE_ERROR is returned.
+                                It is not used for interrupt IN endpoints, which return
+                                EFI_TIMEOUT at once if no data is available yet.
   @param  Translator            A pointr to the transaction translator data.
   @param  TransferResult        A pointer to the detailed result information of the
                                 bulk transfer.
@@ -883,6 +885,7 @@ XhcPeiBulkTransfer (
   PEI_XHC_DEV                   *Xhc;
   URB                           *Urb;
   UINT8                         SlotId;
+  UINT8                         Dci;
   EFI_STATUS                    Status;
   EFI_STATUS                    RecoveryStatus;
   BOOLEAN                       IsInterruptTransfer;
@@ -937,6 +940,27 @@ XhcPeiBulkTransfer (
     goto ON_EXIT;
   }
 
+  //
+  // Interrupt IN endpoints, such as the keyboard report endpoint, keep a transfer
+  // queued and are polled without waiting for the device to answer.
+  //
+  Dci = XhcPeiEndpointToDci ((UINT8) (EndPointAddress & 0x0F),
+                             ((EndPointAddress & 0x80) != 0) ? EfiUsbDataIn : EfiUsbDataOut);
+  if (XhcPeiGetEndpointType (Xhc, SlotId, Dci) == ED_INTERRUPT_IN) {
+    IsInterruptTransfer = TRUE;
+    Status = XhcPeiPollAsyncIntTransfer (
+               Xhc,
+               DeviceAddress,
+               EndPointAddress,
+               DeviceSpeed,
+               MaximumPacketLength,
+               Data[0],
+               DataLength,
+               TransferResult
+               );
+    goto ON_EXIT;
+  }
+
   //
   // Create a new URB, insert it into the asynchronous
   // schedule list, then poll the execution status.
@@ -1461,6 +1485,8 @@ UsbDeinitCtrl (
 
   XhcPeiHaltHC (Xhc, XHC_GENERIC_TIMEOUT);
 
+  XhcPeiFreeAsyncIntTransfer (Xhc);
+
   XhcPeiFreeSched (Xhc);
 
   XhcPeiFreeDevContext (Xhc);
@@ -178,6 +178,10 @@ struct _PEI_XHC_DEV {
   // EventRing
   //
   EVENT_RING                        EventRing;
+  //
+  // Interrupt IN transfer kept queued for non-blocking polling
+  //
+  URB                               *AsyncIntUrb;
 
   //
   // Store device contexts managed by XHCI device
@@ -222,6 +222,8 @@ XhcPeiCreateTransferTrb (
   UINTN                         TotalLen;
   UINTN                         Len;
   UINTN                         TrbNum;
+  UINTN                         TdSize;
+  LINK_TRB                      *LinkTrb;
   EDKII_IOMMU_OPERATION         MapOp;
   EFI_PHYSICAL_ADDRESS          PhyAddr;
   VOID                          *Map;
@@ -365,23 +367,34 @@ XhcPeiCreateTransferTrb (
 
     case ED_BULK_OUT:
     case ED_BULK_IN:
+      //
+      // Queue the whole URB as a single TD so that the device can stream it
+      // without waiting for a doorbell per chunk. A TRB buffer must not cross a
+      // 64KB boundary, so split on 64KB boundaries and chain the TRBs together.
+      // IOC is kept on every TRB so the completed length can be accumulated from
+      // the events, which are all reaped in one pass over the event ring.
+      //
       TotalLen = 0;
       Len      = 0;
       TrbNum   = 0;
       TrbStart = (TRB *) (UINTN) EPRing->RingEnqueue;
       while (TotalLen < Urb->DataLen) {
-        if ((TotalLen + 0x10000) >= Urb->DataLen) {
+        Len = 0x10000 - (((UINTN) Urb->DataPhy + TotalLen) & 0xFFFF);
+        if ((TotalLen + Len) >= Urb->DataLen) {
           Len = Urb->DataLen - TotalLen;
-        } else {
-          Len = 0x10000;
         }
+        //
+        // TD Size is the number of packets still to be sent after this TRB
+        //
+        TdSize = (Urb->DataLen - TotalLen - Len + Urb->Ep.MaxPacket - 1) / Urb->Ep.MaxPacket;
         TrbStart = (TRB *)(UINTN)EPRing->RingEnqueue;
         TrbStart->TrbNormal.TRBPtrLo  = XHC_LOW_32BIT((UINT8 *) Urb->DataPhy + TotalLen);
         TrbStart->TrbNormal.TRBPtrHi  = XHC_HIGH_32BIT((UINT8 *) Urb->DataPhy + TotalLen);
         TrbStart->TrbNormal.Length    = (UINT32) Len;
-        TrbStart->TrbNormal.TDSize    = 0;
+        TrbStart->TrbNormal.TDSize    = (UINT32) MIN (TdSize, 31);
         TrbStart->TrbNormal.IntTarget = 0;
         TrbStart->TrbNormal.ISP       = 1;
+        TrbStart->TrbNormal.CH        = (TdSize != 0) ? 1 : 0;
         TrbStart->TrbNormal.IOC       = 1;
         TrbStart->TrbNormal.Type      = TRB_TYPE_NORMAL;
         //
@@ -390,6 +403,13 @@ XhcPeiCreateTransferTrb (
         TrbStart->TrbNormal.CycleBit = EPRing->RingPCS & BIT0;
 
         XhcPeiSyncTrsRing (Xhc, EPRing);
+        //
+        // The link TRB is part of the TD if the chain wraps around the ring
+        //
+        if ((UINTN) EPRing->RingEnqueue < (UINTN) TrbStart) {
+          LinkTrb = (LINK_TRB *) ((TRB_TEMPLATE *) EPRing->RingSeg0 + EPRing->TrbNumber - 1);
+          LinkTrb->CH = TrbStart->TrbNormal.CH;
+        }
         TrbNum++;
         TotalLen += Len;
       }
@@ -669,6 +689,11 @@ XhcPeiCheckUrbResult (
     //
     if (XhcPeiIsTransferRingTrb (TRBPtr, Urb)) {
       CheckedUrb = Urb;
+    } else if ((Xhc->AsyncIntUrb != NULL) && XhcPeiIsTransferRingTrb (TRBPtr, Xhc->AsyncIntUrb)) {
+      //
+      // Do not lose the completion of the queued interrupt transfer
+      //
+      CheckedUrb = Xhc->AsyncIntUrb;
     } else {
       continue;
     }
@@ -711,6 +736,15 @@ XhcPeiCheckUrbResult (
           CheckedUrb->Completed += (((TRANSFER_TRB_NORMAL*)TRBPtr)->Length - EvtTrb->Length);
         }
 
+        //
+        // A short packet ends a chained TD early, and no event is reported for
+        // the remaining TRBs of that TD.
+        //
+        if ((EvtTrb->Completecode == TRB_COMPLETION_SHORT_PACKET) &&
+            (TRBType == TRB_TYPE_NORMAL) && (((TRANSFER_TRB_NORMAL*)TRBPtr)->CH != 0)) {
+          CheckedUrb->EndDone = TRUE;
+        }
+
         break;
 
       default:
@@ -828,6 +862,168 @@ XhcPeiExecTransfer (
   return Status;
 }
 
+/**
+  Get the endpoint type from the output device context.
+
+  @param  Xhc               The XHCI device.
+  @param  SlotId            The slot id of the target device.
+  @param  Dci               The device context index of the endpoint.
+
+  @return The endpoint type.
+
+**/
+UINT8
+XhcPeiGetEndpointType (
+  IN PEI_XHC_DEV            *Xhc,
+  IN UINT8                  SlotId,
+  IN UINT8                  Dci
+  )
+{
+  VOID                      *OutputContext;
+
+  OutputContext = Xhc->UsbDevContext[SlotId].OutputContext;
+  if (Xhc->HcCParams.Data.Csz == 0) {
+    return (UINT8) ((DEVICE_CONTEXT *)OutputContext)->EP[Dci-1].EPType;
+  } else {
+    return (UINT8) ((DEVICE_CONTEXT_64 *)OutputContext)->EP[Dci-1].EPType;
+  }
+}
+
+/**
+  Free the interrupt transfer kept queued by XhcPeiPollAsyncIntTransfer.
+
+  The caller must make sure the transfer is no longer pending on the endpoint,
+  either by stopping the endpoint or by halting the host controller.
+
+  @param  Xhc               The XHCI device.
+
+**/
+VOID
+XhcPeiFreeAsyncIntTransfer (
+  IN PEI_XHC_DEV            *Xhc
+  )
+{
+  URB                       *Urb;
+  VOID                      *Buffer;
+
+  Urb = Xhc->AsyncIntUrb;
+  if (Urb == NULL) {
+    return;
+  }
+
+  Buffer = Urb->Data;
+  XhcPeiFreeUrb (Xhc, Urb);
+  FreePool (Buffer);
+  Xhc->AsyncIntUrb = NULL;
+}
+
+/**
+  Poll an interrupt IN transfer that is kept queued on the endpoint.
+
+  The first call queues the transfer into a private buffer and returns. Later
+  calls only check the event ring for its completion without waiting. When a
+  report has been received, it is copied into the caller buffer and the transfer
+  is queued again, so the device can always answer the next interrupt poll.
+
+  @param  Xhc               The XHCI device.
+  @param  BusAddr           The logical device address assigned by UsbBus driver.
+  @param  EpAddr            The endpoint address.
+  @param  DevSpeed          The device speed.
+  @param  MaxPacket         The max packet length of the endpoint.
+  @param  Data              The buffer to receive the report.
+  @param  DataLength        On input, the size of Data. On output, the size of
+                            the received report.
+  @param  TransferResult    The result of the USB transfer.
+
+  @retval EFI_SUCCESS           A report was received.
+  @retval EFI_TIMEOUT           No report is available yet.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate the transfer.
+  @retval EFI_DEVICE_ERROR      The transfer failed.
+
+**/
+EFI_STATUS
+XhcPeiPollAsyncIntTransfer (
+  IN     PEI_XHC_DEV        *Xhc,
+  IN     UINT8              BusAddr,
+  IN     UINT8              EpAddr,
+  IN     UINT8              DevSpeed,
+  IN     UINTN              MaxPacket,
+  OUT    VOID               *Data,
+  IN OUT UINTN              *DataLength,
+  OUT    UINT32             *TransferResult
+  )
+{
+  URB                       *Urb;
+  VOID                      *Buffer;
+  UINT8                     SlotId;
+  UINT8                     Dci;
+  EFI_STATUS                Status;
+
+  SlotId = XhcPeiBusDevAddrToSlotId (Xhc, BusAddr);
+  if (SlotId == 0) {
+    return EFI_DEVICE_ERROR;
+  }
+  Dci = XhcPeiEndpointToDci ((UINT8) (EpAddr & 0x0F), EfiUsbDataIn);
+
+  //
+  // Only one interrupt transfer is kept queued. Cancel it if another endpoint
+  // is polled now.
+  //
+  Urb = Xhc->AsyncIntUrb;
+  if ((Urb != NULL) && ((Urb->Ep.BusAddr != BusAddr) || (Urb->Ep.EpAddr != (EpAddr & 0x0F)) ||
+                        (Urb->DataLen != *DataLength))) {
+    if (!Urb->Finished) {
+      XhcPeiDequeueTrbFromEndpoint (Xhc, Urb);
+    }
+    XhcPeiFreeAsyncIntTransfer (Xhc);
+    Urb = NULL;
+  }
+
+  *TransferResult = EFI_USB_NOERROR;
+  if (Urb == NULL) {
+    Buffer = AllocateZeroPool (*DataLength);
+    if (Buffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Urb = XhcPeiCreateUrb (Xhc, BusAddr, EpAddr, DevSpeed, MaxPacket, XHC_INT_TRANSFER_ASYNC,
+                           NULL, Buffer, *DataLength, NULL, NULL);
+    if (Urb == NULL) {
+      FreePool (Buffer);
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Xhc->AsyncIntUrb = Urb;
+    XhcPeiRingDoorBell (Xhc, SlotId, Dci);
+    return EFI_TIMEOUT;
+  }
+
+  if (!XhcPeiCheckUrbResult (Xhc, Urb)) {
+    return EFI_TIMEOUT;
+  }
+
+  *TransferResult = Urb->Result;
+  if (Urb->Result == EFI_USB_NOERROR) {
+    *DataLength = MIN (*DataLength, Urb->Completed);
+    CopyMem (Data, Urb->Data, *DataLength);
+    Status = EFI_SUCCESS;
+  } else {
+    if ((Urb->Result == EFI_USB_ERR_STALL) || (Urb->Result == EFI_USB_ERR_BABBLE)) {
+      XhcPeiRecoverHaltedEndpoint (Xhc, Urb);
+    }
+    Status = EFI_DEVICE_ERROR;
+  }
+
+  //
+  // Queue the transfer again to receive the next report in the background
+  //
+  if (EFI_ERROR (XhcPeiCreateTransferTrb (Xhc, Urb))) {
+    XhcPeiFreeAsyncIntTransfer (Xhc);
+  } else {
+    XhcPeiRingDoorBell (Xhc, SlotId, Dci);
+  }
+
+  return Status;
+}
+
 /**
   Monitor the port status change. Enable/Disable device slot if there is a device attached/detached.
 
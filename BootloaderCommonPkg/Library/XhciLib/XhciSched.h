@@ -16,6 +16,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define XHC_CTRL_TRANSFER                       0x01
 #define XHC_BULK_TRANSFER                       0x02
 #define XHC_INT_TRANSFER_SYNC                   0x04
+#define XHC_INT_TRANSFER_ASYNC                  0x08
 
 //
 // 6.4.6 TRB Types
@@ -752,6 +753,73 @@ typedef struct _INPUT_CONTEXT_64 {
   ENDPOINT_CONTEXT_64       EP[31];
 } INPUT_CONTEXT_64;
 
+/**
+  Get the endpoint type from the output device context.
+
+  @param  Xhc               The XHCI device.
+  @param  SlotId            The slot id of the target device.
+  @param  Dci               The device context index of the endpoint.
+
+  @return The endpoint type.
+
+**/
+UINT8
+XhcPeiGetEndpointType (
+  IN PEI_XHC_DEV            *Xhc,
+  IN UINT8                  SlotId,
+  IN UINT8                  Dci
+  );
+
+/**
+  Free the interrupt transfer kept queued by XhcPeiPollAsyncIntTransfer.
+
+  The caller must make sure the transfer is no longer pending on the endpoint,
+  either by stopping the endpoint or by halting the host controller.
+
+  @param  Xhc               The XHCI device.
+
+**/
+VOID
+XhcPeiFreeAsyncIntTransfer (
+  IN PEI_XHC_DEV            *Xhc
+  );
+
+/**
+  Poll an interrupt IN transfer that is kept queued on the endpoint.
+
+  The first call queues the transfer into a private buffer and returns. Later
+  calls only check the event ring for its completion without waiting. When a
+  report has been received, it is copied into the caller buffer and the transfer
+  is queued again, so the device can always answer the next interrupt poll.
+
+  @param  Xhc               The XHCI device.
+  @param  BusAddr           The logical device address assigned by UsbBus driver.
+  @param  EpAddr            The endpoint address.
+  @param  DevSpeed          The device speed.
+  @param  MaxPacket         The max packet length of the endpoint.
+  @param  Data              The buffer to receive the report.
+  @param  DataLength        On input, the size of Data. On output, the size of
+                            the received report.
+  @param  TransferResult    The result of the USB transfer.
+
+  @retval EFI_SUCCESS           A report was received.
+  @retval EFI_TIMEOUT           No report is available yet.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate the transfer.
+  @retval EFI_DEVICE_ERROR      The transfer failed.
+
+**/
+EFI_STATUS
+XhcPeiPollAsyncIntTransfer (
+  IN     PEI_XHC_DEV        *Xhc,
+  IN     UINT8              BusAddr,
+  IN     UINT8              EpAddr,
+  IN     UINT8              DevSpeed,
+  IN     UINTN              MaxPacket,
+  OUT    VOID               *Data,
+  IN OUT UINTN              *DataLength,
+  OUT    UINT32             *TransferResult
+  );
+
 /**
   Execute the transfer by polling the URB. This is a synchronous operation.
 
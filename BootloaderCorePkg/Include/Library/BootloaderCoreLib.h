@@ -117,12 +117,23 @@ typedef struct {
   UINT8         Data[];
 } VBT_ENTRY_HDR;
 
+//
+// ACPI structures resolved on a normal boot so that S3 resume
+// does not need to search the ACPI tables again
+//
+typedef struct {
+  UINT32        Facs;
+  UINT32        FpdtS3Table;
+  UINT32        Crc32;
+} S3_RESUME_INFO;
+
 typedef struct {
-  UINT32        AcpiTop;
-  UINT32        AcpiBase;
-  UINT32        AcpiGnvs;
-  UINT8         BootMediaType;
-  UINT8         BootPartition;
+  UINT32          AcpiTop;
+  UINT32          AcpiBase;
+  UINT32          AcpiGnvs;
+  UINT8           BootMediaType;
+  UINT8           BootPartition;
+  S3_RESUME_INFO  ResumeInfo;
 } S3_DATA;
 
 #pragma pack()
@@ -100,6 +100,26 @@ MpRunTask (
   );
 
 
+/**
+  Fill a buffer with zeros using all available processors.
+
+  The buffer is split across the APs when they are waiting for tasks,
+  otherwise it is zeroed on the BSP only.
+
+  @param[in]  Buffer      Pointer to the buffer to fill with zeros.
+  @param[in]  Length      Number of bytes in Buffer to fill with zeros.
+
+  @retval     Buffer
+
+**/
+VOID *
+EFIAPI
+MpZeroMem (
+  IN  VOID          *Buffer,
+  IN  UINTN          Length
+  );
+
+
 /**
   Dump MP task state
 
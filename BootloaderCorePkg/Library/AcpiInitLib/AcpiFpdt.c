@@ -12,6 +12,7 @@
 #include <Library/BootloaderCoreLib.h>
 #include <Library/AcpiInitLib.h>
 #include <Library/TimeStampLib.h>
+#include "AcpiInitLibInternal.h"
 
 BOOT_PERFORMANCE_TABLE mBootPerformanceTableTemplate = {
   {
@@ -150,8 +151,16 @@ UpdateFpdtS3Table (
   UINT64                              TimeInMs;
   UINT64                              TotalResumeTime;
   EFI_ACPI_5_0_FPDT_S3_RESUME_RECORD  *S3Resume;
+  S3_RESUME_INFO                      *ResumeInfo;
 
-  S3PerfTable = (S3_PERFORMANCE_TABLE *)GetFpdtS3Table (AcpiTableBase);
+  S3PerfTable = NULL;
+  ResumeInfo  = GetS3ResumeInfo ();
+  if (ResumeInfo != NULL) {
+    S3PerfTable = (S3_PERFORMANCE_TABLE *)(UINTN)ResumeInfo->FpdtS3Table;
+  }
+  if ((S3PerfTable == NULL) || (S3PerfTable->Header.Signature != EFI_ACPI_5_0_FPDT_S3_PERFORMANCE_TABLE_SIGNATURE)) {
+    S3PerfTable = (S3_PERFORMANCE_TABLE *)GetFpdtS3Table (AcpiTableBase);
+  }
   if (S3PerfTable == NULL) {
     return EFI_NOT_FOUND;
   }
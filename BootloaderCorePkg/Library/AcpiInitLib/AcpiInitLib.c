@@ -83,11 +83,20 @@ AcpiPlatformChecksum (
 /**
   This function updates GNVS data structure base address dynamically.
 
+  The GNVS OperationRegion is declared with a DWORD base and a WORD size
+  placeholder, which iasl encodes as:
+    ExtOp RegionOp 'GNVS' SystemMemory DWordPrefix <Base> WordPrefix <Size>
+  Only a region matching this encoding is patched so that a differently
+  encoded region never gets its bytes overwritten.
+
   @param[in]  Dsdt          Pointer to DSDT table
   @param[in]  GnvsBase      Physical address of the GNVS data structure
 
+  @retval EFI_SUCCESS       The GNVS region was found and updated.
+  @retval EFI_NOT_FOUND     The GNVS region was not found in the DSDT.
+
 **/
-VOID
+EFI_STATUS
 UpdateAcpiGnvs (
   IN EFI_ACPI_DESCRIPTION_HEADER   *Dsdt,
   IN UINT32                         GnvsBase
@@ -96,23 +105,30 @@ UpdateAcpiGnvs (
   UINT8 *Ptr;
   UINT8 *End;
 
-  Ptr = (UINT8 *)Dsdt;
-  End = (UINT8 *)Dsdt + Dsdt->Length;
+  Ptr = (UINT8 *)Dsdt + sizeof (EFI_ACPI_DESCRIPTION_HEADER);
+  End = (UINT8 *)Dsdt + Dsdt->Length - 13;
 
   /*
    * Loop through the ASL looking for values that we must fix up.
+   * The region is declared ahead of any method, so this ends early.
    */
   for (; Ptr < End; Ptr++) {
     if (* (UINT32 *)Ptr != SIGNATURE_32 ('G', 'N', 'V', 'S')) {
       continue;
     }
-    if (* (Ptr - 1) != AML_EXT_REGION_OP) {
+    if ((* (Ptr - 2) != AML_EXT_OP) || (* (Ptr - 1) != AML_EXT_REGION_OP)) {
+      continue;
+    }
+    if ((* (Ptr + 5) != AML_DWORD_PREFIX) || (* (Ptr + 10) != AML_WORD_PREFIX)) {
       continue;
     }
     * (UINT32 *) (Ptr + 6)  = GnvsBase;
     * (UINT16 *) (Ptr + 11) = (UINT16)GetAcpiGnvsSize();
-    break;
+    return EFI_SUCCESS;
   }
+
+  DEBUG ((DEBUG_ERROR, "GNVS OperationRegion not found in DSDT\n"));
+  return EFI_NOT_FOUND;
 }
 
 /**
@@ -249,11 +265,17 @@ AcpiTableUpdate (
       Facp = (EFI_ACPI_5_0_FIXED_ACPI_DESCRIPTION_TABLE *)FindAcpiTableBySignature (
              Rsdt, EFI_ACPI_5_0_FIXED_ACPI_DESCRIPTION_TABLE_SIGNATURE, &EntryIndex);
       if (Facp != NULL) {
+        // Keep the current DSDT if the new one cannot reach GNVS
+        Status = UpdateAcpiGnvs (AcpiHdr, PcdGet32 (PcdAcpiGnvsAddress));
+        if (EFI_ERROR (Status)) {
+          DEBUG ((DEBUG_INFO, "Skipped\n"));
+          Current = Previous;
+          continue;
+        }
         DEBUG ((DEBUG_INFO, "Replaced\n"));
         Facp->Dsdt  = (UINT32)(UINTN)AcpiHdr;
         Facp->XDsdt = (UINT64)(UINTN)AcpiHdr;
         AcpiPlatformChecksum ((UINT8 *)Facp, Facp->Header.Length);
-        UpdateAcpiGnvs (AcpiHdr, PcdGet32 (PcdAcpiGnvsAddress));
       } else {
         Status = EFI_ABORTED;
         break;
@@ -465,6 +487,40 @@ UpdateFwst (
   return EFI_SUCCESS;
 }
 
+/**
+  Save the ACPI structures needed on S3 resume.
+
+  This function is called on normal boot flow after the ACPI tables are
+  built. The pointers are protected by a CRC32 and checked against the ACPI
+  memory range before they are used on S3 resume.
+
+  @param[in]  Rsdp    Pointer to the RSDP.
+  @param[in]  Facs    Pointer to the FACS.
+
+**/
+STATIC
+VOID
+SaveS3ResumeInfo (
+  IN  EFI_ACPI_5_0_ROOT_SYSTEM_DESCRIPTION_POINTER   *Rsdp,
+  IN  EFI_ACPI_5_0_FIRMWARE_ACPI_CONTROL_STRUCTURE   *Facs
+  )
+{
+  LOADER_GLOBAL_DATA    *LdrGlobal;
+  S3_DATA               *S3Data;
+  S3_RESUME_INFO        *ResumeInfo;
+
+  LdrGlobal = (LOADER_GLOBAL_DATA *)GetLoaderGlobalDataPointer();
+  S3Data    = (S3_DATA *)LdrGlobal->S3DataPtr;
+  if (S3Data == NULL) {
+    return;
+  }
+
+  ResumeInfo = &S3Data->ResumeInfo;
+  ResumeInfo->Facs        = (UINT32)(UINTN)Facs;
+  ResumeInfo->FpdtS3Table = (UINT32)GetFpdtS3Table ((UINT32)(UINTN)Rsdp);
+  ResumeInfo->Crc32       = CalculateCrc32 (ResumeInfo, OFFSET_OF (S3_RESUME_INFO, Crc32));
+}
+
 /**
   This function creates necessary ACPI tables and puts the RSDP
   table in F segment so that OS can locate it.
@@ -604,8 +660,11 @@ AcpiInit (
           break;
         case EFI_ACPI_5_0_DIFFERENTIATED_SYSTEM_DESCRIPTION_TABLE_SIGNATURE:
           // DSDT
-          Dsdt = (EFI_ACPI_DESCRIPTION_HEADER *)Current;
-          UpdateAcpiGnvs (Dsdt, PcdGet32 (PcdAcpiGnvsAddress));
+          // A DSDT that cannot reach GNVS is not added
+          Status = UpdateAcpiGnvs ((EFI_ACPI_DESCRIPTION_HEADER *)Current, PcdGet32 (PcdAcpiGnvsAddress));
+          if (!EFI_ERROR(Status)) {
+            Dsdt = (EFI_ACPI_DESCRIPTION_HEADER *)Current;
+          }
           UpdateRdstXsdt = 0;
           break;
         case EFI_ACPI_5_0_PCI_EXPRESS_MEMORY_MAPPED_CONFIGURATION_SPACE_BASE_ADDRESS_DESCRIPTION_TABLE_SIGNATURE:
@@ -698,6 +757,8 @@ AcpiInit (
   Rsdp->ExtendedChecksum = CalculateCheckSum8 ((UINT8 *)Rsdp, Rsdp->Length);
   *AcpiMemBase = (UINT32)(UINTN)Current;
 
+  SaveS3ResumeInfo (Rsdp, Facs);
+
   Status = PcdSet32S (PcdAcpiTablesRsdp, (UINT32)(UINTN)Rsdp);
 
   //
@@ -720,17 +781,55 @@ typedef VOID (*DOWAKEUP) (UINT32 WakeVector);
 
 
 /**
-  This function is called on S3 boot flow only.
+  Get the S3 resume info saved on the last normal boot.
 
-  It will locate the S3 waking vector from the ACPI table and then
-  jump into it. The control will never return.
+  @retval   Pointer to the S3 resume info, or NULL if it is not valid.
+ **/
+S3_RESUME_INFO *
+GetS3ResumeInfo (
+  VOID
+  )
+{
+  LOADER_GLOBAL_DATA    *LdrGlobal;
+  S3_DATA               *S3Data;
+  S3_RESUME_INFO        *ResumeInfo;
+
+  LdrGlobal = (LOADER_GLOBAL_DATA *)GetLoaderGlobalDataPointer();
+  S3Data    = (S3_DATA *)LdrGlobal->S3DataPtr;
+  if (S3Data == NULL) {
+    return NULL;
+  }
+
+  ResumeInfo = &S3Data->ResumeInfo;
+  if (CalculateCrc32 (ResumeInfo, OFFSET_OF (S3_RESUME_INFO, Crc32)) != ResumeInfo->Crc32) {
+    return NULL;
+  }
+
+  //
+  // Both structures are created inside the ACPI reclaim memory
+  //
+  if ((ResumeInfo->Facs < S3Data->AcpiBase) || (ResumeInfo->Facs >= S3Data->AcpiTop)) {
+    return NULL;
+  }
+  if ((ResumeInfo->FpdtS3Table != 0) &&
+      ((ResumeInfo->FpdtS3Table < S3Data->AcpiBase) || (ResumeInfo->FpdtS3Table >= S3Data->AcpiTop))) {
+    return NULL;
+  }
+
+  return ResumeInfo;
+}
+
+/**
+  Locate the FACS by searching the ACPI tables.
 
   @param  AcpiTableBase   ACPI table base address
 
+  @retval   Pointer to the FACS, or NULL if it is not found.
+
 **/
-VOID
-EFIAPI
-FindAcpiWakeVectorAndJump (
+STATIC
+EFI_ACPI_5_0_FIRMWARE_ACPI_CONTROL_STRUCTURE *
+FindAcpiFacs (
   IN  UINT32    AcpiTableBase
   )
 {
@@ -741,8 +840,6 @@ FindAcpiWakeVectorAndJump (
   UINT8                                           Index;
   EFI_ACPI_5_0_FIRMWARE_ACPI_CONTROL_STRUCTURE   *Facs;
   EFI_ACPI_5_0_FIXED_ACPI_DESCRIPTION_TABLE      *Facp;
-  UINT32                                          WakeVector;
-  DOWAKEUP                                        DoWake;
 
   Rsdp = (EFI_ACPI_5_0_ROOT_SYSTEM_DESCRIPTION_POINTER *)(UINTN)AcpiTableBase;
   Xsdt = (EFI_ACPI_DESCRIPTION_HEADER *)(UINTN)Rsdp->XsdtAddress;
@@ -758,22 +855,61 @@ FindAcpiWakeVectorAndJump (
         Facs = (EFI_ACPI_5_0_FIRMWARE_ACPI_CONTROL_STRUCTURE *)(UINTN)Facp->FirmwareCtrl;
       }
       if (Facs->Signature == EFI_ACPI_5_0_FIRMWARE_ACPI_CONTROL_STRUCTURE_SIGNATURE) {
-        WakeVector = Facs->FirmwareWakingVector;
-        // Calculate CRC32 for 0x00000000 ---> BootLoaderRsvdMemBase and
-        // compare with the one calculated and saved in Stage1B.
-        if (PcdGetBool (PcdS3DebugEnabled)) {
-          if (!S3DebugRestoreAndCompareCRC32 () ) {
-            return;
-          }
-        }
-        CopyMem ((VOID *)(UINTN)WakeUpBuffer, (VOID *)(UINTN)&WakeUp, WakeUpSize);
-        DoWake = (DOWAKEUP)(UINTN)WakeUpBuffer;
-        DEBUG ((DEBUG_INIT, "Jump to Wake vector = 0x%x\n", WakeVector));
-        DoWake (WakeVector);
-        //
-        // Should never reach here!
-        //
+        return Facs;
       }
     }
   }
+
+  return NULL;
+}
+
+/**
+  This function is called on S3 boot flow only.
+
+  It will locate the S3 waking vector from the ACPI table and then
+  jump into it. The control will never return. The FACS saved on the
+  last normal boot is used if it is still valid, otherwise the ACPI
+  tables are searched.
+
+  @param  AcpiTableBase   ACPI table base address
+
+**/
+VOID
+EFIAPI
+FindAcpiWakeVectorAndJump (
+  IN  UINT32    AcpiTableBase
+  )
+{
+  EFI_ACPI_5_0_FIRMWARE_ACPI_CONTROL_STRUCTURE   *Facs;
+  S3_RESUME_INFO                                 *ResumeInfo;
+  UINT32                                          WakeVector;
+  DOWAKEUP                                        DoWake;
+
+  Facs       = NULL;
+  ResumeInfo = GetS3ResumeInfo ();
+  if (ResumeInfo != NULL) {
+    Facs = (EFI_ACPI_5_0_FIRMWARE_ACPI_CONTROL_STRUCTURE *)(UINTN)ResumeInfo->Facs;
+  }
+  if ((Facs == NULL) || (Facs->Signature != EFI_ACPI_5_0_FIRMWARE_ACPI_CONTROL_STRUCTURE_SIGNATURE)) {
+    Facs = FindAcpiFacs (AcpiTableBase);
+  }
+  if (Facs == NULL) {
+    return;
+  }
+
+  WakeVector = Facs->FirmwareWakingVector;
+  // Calculate CRC32 for 0x00000000 ---> BootLoaderRsvdMemBase and
+  // compare with the one calculated and saved in Stage1B.
+  if (PcdGetBool (PcdS3DebugEnabled)) {
+    if (!S3DebugRestoreAndCompareCRC32 () ) {
+      return;
+    }
+  }
+  CopyMem ((VOID *)(UINTN)WakeUpBuffer, (VOID *)(UINTN)&WakeUp, WakeUpSize);
+  DoWake = (DOWAKEUP)(UINTN)WakeUpBuffer;
+  DEBUG ((DEBUG_INIT, "Jump to Wake vector = 0x%x\n", WakeVector));
+  DoWake (WakeVector);
+  //
+  // Should never reach here!
+  //
 }
@@ -72,4 +72,26 @@ UpdateFpdt (
   OUT UINT32                            *ExtraSize
   );
 
+/**
+  Get FPDT S3 performance table by searching ACPI table
+
+  @param[in]  AcpiTableBase    ACPI table base address
+
+  @retval S3 performance table address     Value 0 means not found.
+**/
+UINTN
+GetFpdtS3Table (
+  IN  UINT32                                   AcpiTableBase
+  );
+
+/**
+  Get the S3 resume info saved on the last normal boot.
+
+  @retval   Pointer to the S3 resume info, or NULL if it is not valid.
+ **/
+S3_RESUME_INFO *
+GetS3ResumeInfo (
+  VOID
+  );
+
 #endif
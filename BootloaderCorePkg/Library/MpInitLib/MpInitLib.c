@@ -14,6 +14,7 @@ STATIC volatile MP_DATA_EXCHANGE_STRUCT   mMpDataStruct;
 STATIC UINT8                             *mBackupBuffer;
 STATIC UINT32                             mMpInitPhase = EnumMpInitNull;
 STATIC SMMBASE_INFO                      *mSmmBaseInfo = NULL;
+STATIC MP_ZERO_MEM_RANGE                  mZeroMemRange[FixedPcdGet32 (PcdCpuMaxLogicalProcessorNumber)];
 
 extern UINT8                             *mDefaultSmiHandlerStart;
 extern UINT8                             *mDefaultSmiHandlerRet;
@@ -615,3 +616,95 @@ MpDumpTask (
   }
   DEBUG ((DEBUG_INFO, "\n"));
 }
+
+
+/**
+  AP task to zero a memory range.
+
+  @param[in]  Argument    Pointer to the MP_ZERO_MEM_RANGE to zero.
+
+  @retval     0
+
+**/
+STATIC
+UINT64
+EFIAPI
+MpZeroMemTask (
+  IN  UINT64         Argument
+  )
+{
+  MP_ZERO_MEM_RANGE  *Range;
+
+  Range = (MP_ZERO_MEM_RANGE *)(UINTN)Argument;
+  ZeroMem ((VOID *)(UINTN)Range->Base, (UINTN)Range->Length);
+  return 0;
+}
+
+
+/**
+  Fill a buffer with zeros using all available processors.
+
+  Large buffers are split into page aligned chunks. Each AP that is waiting
+  for a task zeros one chunk while the BSP zeros the first one. Small buffers,
+  or calls made while the APs are not in the task loop, are zeroed on the BSP.
+
+  @param[in]  Buffer      Pointer to the buffer to fill with zeros.
+  @param[in]  Length      Number of bytes in Buffer to fill with zeros.
+
+  @retval     Buffer
+
+**/
+VOID *
+EFIAPI
+MpZeroMem (
+  IN  VOID          *Buffer,
+  IN  UINTN          Length
+  )
+{
+  UINT32             Index;
+  UINT32             CpuCount;
+  UINTN              Chunk;
+  UINTN              Offset;
+  BOOLEAN            Dispatched[FixedPcdGet32 (PcdCpuMaxLogicalProcessorNumber)];
+
+  CpuCount = mSysCpuTask.CpuCount;
+  if ((mMpInitPhase != EnumMpInitRun) || (CpuCount <= 1) || (Length < MP_ZERO_MEM_MIN_SIZE)) {
+    return ZeroMem (Buffer, Length);
+  }
+
+  Chunk  = ALIGN_VALUE (Length / CpuCount, MP_ZERO_MEM_ALIGNMENT);
+  Offset = 0;
+  for (Index = 0; Index < CpuCount; Index++) {
+    mZeroMemRange[Index].Base   = (UINTN)Buffer + Offset;
+    mZeroMemRange[Index].Length = MIN (Chunk, Length - Offset);
+    Offset += (UINTN)mZeroMemRange[Index].Length;
+  }
+
+  //
+  // Hand out chunks 1..N to the APs, the BSP takes chunk 0 and any chunk
+  // an AP was not ready for.
+  //
+  for (Index = 1; Index < CpuCount; Index++) {
+    Dispatched[Index] = FALSE;
+    if (mZeroMemRange[Index].Length != 0) {
+      Dispatched[Index] = !EFI_ERROR (MpRunTask (Index, MpZeroMemTask, (UINT64)(UINTN)&mZeroMemRange[Index]));
+    }
+  }
+
+  MpZeroMemTask ((UINT64)(UINTN)&mZeroMemRange[0]);
+  for (Index = 1; Index < CpuCount; Index++) {
+    if (!Dispatched[Index]) {
+      MpZeroMemTask ((UINT64)(UINTN)&mZeroMemRange[Index]);
+    }
+  }
+
+  for (Index = 1; Index < CpuCount; Index++) {
+    if (Dispatched[Index]) {
+      while (mSysCpuTask.CpuTask[Index].State != EnumCpuReady) {
+        CpuPause ();
+      }
+    }
+  }
+
+  return Buffer;
+}
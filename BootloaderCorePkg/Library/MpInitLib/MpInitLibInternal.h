@@ -38,6 +38,9 @@
 #define SMM_BASE_GAP               0x1000
 #define SMM_BASE_MIN_SIZE          0x10000
 
+#define MP_ZERO_MEM_MIN_SIZE       SIZE_1MB
+#define MP_ZERO_MEM_ALIGNMENT      SIZE_4KB
+
 #pragma pack(1)
 typedef struct {
   UINT16            CSSelector;
@@ -83,6 +86,11 @@ typedef struct {
   CPU_TASK         CpuTask[FixedPcdGet32 (PcdCpuMaxLogicalProcessorNumber)];
 } ALL_CPU_TASK;
 
+typedef struct {
+  UINT64           Base;
+  UINT64           Length;
+} MP_ZERO_MEM_RANGE;
+
 /**
   Assembly function to get the BSP.
 
@@ -10,7 +10,6 @@
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/PciExpressLib.h>
-#include <Library/SortLib.h>
 #include <Library/HobLib.h>
 #include <InternalPciEnumerationLib.h>
 #include <Library/BootloaderCommonLib.h>
@@ -19,6 +18,11 @@
 
 #define  DEBUG_PCI_ENUM    0
 
+//
+// One bucket per power-of-two alignment, plus one for zero alignment
+//
+#define  PCI_BAR_ALIGN_BUCKET_NUM   65
+
 UINT8   *mPoolPtr;
 
 STATIC PCI_RES_ALLOC_TABLE  *mResAllocTablePtr;
@@ -904,32 +908,28 @@ PciScanBus (
 }
 
 /**
-  The function is called by PerformInsertionSortList to sort PCI Bar by its alignment.
+  Add a PCI BAR into the resource bucket matching its alignment.
 
-  @param[in] Buffer1         The pointer to first list entry.
-  @param[in] Buffer2         The pointer to second list entry.
+  BARs within a bucket are kept in reverse order of addition, which is the
+  order the previous insertion sort gave to BARs of equal alignment.
 
-  @retval 0                  Buffer2 alignment is less than or equal to Buffer1 alignment.
-  @retval 1                  Buffer2 alignment is greater than Buffer1 alignment.
+  @param[in] AlignBucket     The resource bucket array indexed by alignment.
+  @param[in] PciBar          The PCI BAR to add.
 
 **/
-INTN
-EFIAPI
-ComparePciBarRes (
-  IN CONST VOID                 *Buffer1,
-  IN CONST VOID                 *Buffer2
+VOID
+AddPciBarResource (
+  IN LIST_ENTRY                 *AlignBucket,
+  IN PCI_BAR                    *PciBar
   )
 {
-  PCI_BAR_RESOURCE      *NewResBar;
-  PCI_BAR_RESOURCE      *CurrResBar;
+  PCI_BAR_RESOURCE      *PciBarRes;
+  UINTN                  Index;
 
-  NewResBar   = PCI_BAR_RESOURCE_FROM_LINK (Buffer1);
-  CurrResBar  = PCI_BAR_RESOURCE_FROM_LINK (Buffer2);
-
-  //
-  // Descending Order
-  //
-  return (CurrResBar->PciBar->Alignment > NewResBar->PciBar->Alignment) ? 1 : 0;
+  PciBarRes = (PCI_BAR_RESOURCE *)PciAllocatePool (sizeof (PCI_BAR_RESOURCE));
+  PciBarRes->PciBar = PciBar;
+  Index = (PciBar->Alignment == 0) ? 0 : (UINTN)HighBitSet64 (PciBar->Alignment) + 1;
+  InsertHeadList (&AlignBucket[Index], &PciBarRes->Link);
 }
 
 /**
@@ -1131,17 +1131,20 @@ CalculateResource (
   LIST_ENTRY                *CurrentLink;
   PCI_IO_DEVICE             *PciIoDevice;
   UINT32                     Idx;
-  PCI_BAR_RESOURCE           ParentRes;
+  LIST_ENTRY                 AlignBucket[PCI_BAR_ALIGN_BUCKET_NUM];
   PCI_BAR_RESOURCE          *PciBarRes;
   UINT64                     Base;
   UINT64                     Alignment;
+  UINT64                     Padding;
 
   if ((BarType == PciBarTypeUnknown) || (BarType > PciBarTypePMem64)) {
     return;
   }
 
-  ParentRes.PciBar = NULL;
-  InitializeListHead (&ParentRes.Link);
+  for (Idx = 0; Idx < PCI_BAR_ALIGN_BUCKET_NUM; Idx++) {
+    InitializeListHead (&AlignBucket[Idx]);
+  }
+
   CurrentLink = Parent->ChildList.ForwardLink;
   while (CurrentLink != NULL && CurrentLink != &Parent->ChildList) {
     PciIoDevice = PCI_IO_DEVICE_FROM_LINK (CurrentLink);
@@ -1151,42 +1154,49 @@ CalculateResource (
       //
       for (Idx = 0; Idx < PPB_MAX_BAR; Idx++) {
         if ((PciIoDevice->PpbBar[Idx].Length > 0) && (PciIoDevice->PpbBar[Idx].BarType == BarType)) {
-          PciBarRes = (PCI_BAR_RESOURCE *)PciAllocatePool (sizeof (PCI_BAR_RESOURCE));
-          PciBarRes->PciBar = &PciIoDevice->PpbBar[Idx];
-          PerformInsertionSortList (&ParentRes.Link, &PciBarRes->Link, ComparePciBarRes);
+          AddPciBarResource (AlignBucket, &PciIoDevice->PpbBar[Idx]);
         }
       }
       CalculateResource (PciIoDevice, BarType);
     }
     for (Idx = 0; Idx < PCI_MAX_BAR; Idx++) {
       if (PciIoDevice->PciBar[Idx].BarType == BarType) {
-        PciBarRes = (PCI_BAR_RESOURCE *)PciAllocatePool (sizeof (PCI_BAR_RESOURCE));
-        PciBarRes->PciBar = &PciIoDevice->PciBar[Idx];
-        PerformInsertionSortList (&ParentRes.Link, &PciBarRes->Link, ComparePciBarRes);
+        AddPciBarResource (AlignBucket, &PciIoDevice->PciBar[Idx]);
       }
       if (FeaturePcdGet (PcdSrIovSupport)) {
         if (PciIoDevice->VfPciBar[Idx].BarType == BarType) {
-          PciBarRes = (PCI_BAR_RESOURCE *)PciAllocatePool (sizeof (PCI_BAR_RESOURCE));
-          PciBarRes->PciBar = &PciIoDevice->VfPciBar[Idx];
-          PerformInsertionSortList (&ParentRes.Link, &PciBarRes->Link, ComparePciBarRes);
+          AddPciBarResource (AlignBucket, &PciIoDevice->VfPciBar[Idx]);
         }
       }
     }
     CurrentLink = CurrentLink->ForwardLink;
   }
 
+  //
+  // Place BARs in descending alignment order so that only the alignment
+  // steps between buckets can leave gaps
+  //
   Base      = 0;
   Alignment = 0;
-  CurrentLink = ParentRes.Link.ForwardLink;
-  while (CurrentLink != NULL && CurrentLink != &ParentRes.Link) {
-    PciBarRes = PCI_BAR_RESOURCE_FROM_LINK (CurrentLink);
-    if (Alignment == 0) {
-      Alignment = PciBarRes->PciBar->Alignment;
+  Padding   = 0;
+  for (Idx = PCI_BAR_ALIGN_BUCKET_NUM; Idx > 0; Idx--) {
+    CurrentLink = AlignBucket[Idx - 1].ForwardLink;
+    while (CurrentLink != &AlignBucket[Idx - 1]) {
+      PciBarRes = PCI_BAR_RESOURCE_FROM_LINK (CurrentLink);
+      if (Alignment == 0) {
+        Alignment = PciBarRes->PciBar->Alignment;
+      }
+      Padding += ALIGN (Base, PciBarRes->PciBar->Alignment) - Base;
+      Base = ALIGN (Base, PciBarRes->PciBar->Alignment);
+      PciBarRes->PciBar->BaseAddress = Base;
+      Base += PciBarRes->PciBar->Length;
+      CurrentLink = CurrentLink->ForwardLink;
     }
-    Base = ALIGN (Base, PciBarRes->PciBar->Alignment);
-    PciBarRes->PciBar->BaseAddress = Base;
-    Base += PciBarRes->PciBar->Length;
-    CurrentLink = CurrentLink->ForwardLink;
+  }
+
+  if (Padding > 0) {
+    DEBUG ((DEBUG_VERBOSE, "PCI 0x%08X BarType %d: 0x%lX used, 0x%lX alignment padding\n",
+            Parent->Address, BarType, Base, Padding));
   }
 
   if (BarType <= PciBarTypeIo32) {
@@ -1585,7 +1595,11 @@ PciProgramResources (
       ProgramResource (Root, BarType);
 
       ResBase[Index] += Root->PciBar[BarType - 1].Length;
-      ASSERT (ResBase[Index] <= ResLimit[Index]);
+      if (ResBase[Index] > ResLimit[Index]) {
+        DEBUG ((DEBUG_ERROR, "PCI bus 0x%02X BarType %d resource exhausted: 0x%lX at 0x%lX exceeds limit 0x%lX\n",
+                Root->BusNumberRanges.BusBase, BarType, Root->PciBar[BarType - 1].Length, Address, ResLimit[Index]));
+        ASSERT (FALSE);
+      }
     }
 
     CurrentLink = CurrentLink->ForwardLink;
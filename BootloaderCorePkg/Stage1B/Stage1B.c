@@ -573,6 +573,9 @@ SecStartup2 (
   BoardInit (PostMemoryInit);
   AddMeasurePoint (0x2040);
 
+  // Timestamp frequency may have been a fallback if the PM timer was not decoded in Stage1A
+  LdrGlobal->PerfData.FreqKhz = GetTimeStampFrequency ();
+
   // Switch to memory-based stack and continue execution at ContinueFunc
   StackTop  = LdrGlobal->StackTop - (sizeof (STAGE2_PARAM) + sizeof (STAGE1B_PARAM) + 0x40);
   StackTop  = ALIGN_DOWN (StackTop, 0x100);
@@ -7,6 +7,8 @@
 
 #include "Stage2.h"
 
+STATIC PAYLOAD_PREFETCH   mPayloadPrefetch;
+
 /**
   Callback function to add performance measure point during component loading.
 
@@ -49,6 +51,120 @@ LoadComponentCallback (
 
 }
 
+/**
+  Get the container and component name of the payload to load.
+
+  @param[in]   BootMode        Current boot mode.
+  @param[out]  ContainerSig    Pointer to receive container signature or component type.
+  @param[out]  ComponentName   Pointer to receive component name.
+
+**/
+STATIC
+VOID
+GetPayloadComponent (
+  IN  UINT8     BootMode,
+  OUT UINT32   *ContainerSig,
+  OUT UINT32   *ComponentName
+  )
+{
+  UINT32        PayloadId;
+
+  PayloadId = GetPayloadId ();
+  if (BootMode == BOOT_ON_FLASH_UPDATE) {
+    *ContainerSig  = COMP_TYPE_PAYLOAD_FWU;
+    *ComponentName = FLASH_MAP_SIG_FWUPDATE;
+  } else {
+    if (PayloadId == 0) {
+      *ContainerSig  = COMP_TYPE_PAYLOAD;
+      *ComponentName = FLASH_MAP_SIG_PAYLOAD;
+    } else {
+      *ContainerSig  = FLASH_MAP_SIG_EPAYLOAD;
+      *ComponentName = PayloadId;
+    }
+  }
+}
+
+/**
+  AP task to copy the payload component from flash into memory.
+
+  @param[in]  Argument    Pointer to the PAYLOAD_PREFETCH structure.
+
+  @retval     0
+
+**/
+STATIC
+UINT64
+EFIAPI
+PayloadPrefetchTask (
+  IN  UINT64    Argument
+  )
+{
+  PAYLOAD_PREFETCH  *Prefetch;
+
+  Prefetch = (PAYLOAD_PREFETCH *)(UINTN)Argument;
+  CopyMem (Prefetch->Buffer, Prefetch->Source, Prefetch->Length);
+  return 0;
+}
+
+/**
+  Start copying the payload component into memory on an idle AP.
+
+  Reading the payload from flash is the slowest part of loading it, so it
+  is started as soon as the APs are able to run tasks and overlaps with
+  PCI enumeration and ACPI initialization on the BSP. The copy is only a
+  hint: authentication and decompression still run on the BSP when the
+  payload is loaded, and the copy is ignored if the payload selection or
+  location changes in between.
+
+  @param[in]  BootMode    Current boot mode.
+
+**/
+STATIC
+VOID
+StartPayloadPrefetch (
+  IN  UINT8     BootMode
+  )
+{
+  EFI_STATUS             Status;
+  LOADER_GLOBAL_DATA    *LdrGlobal;
+  SYS_CPU_INFO          *SysCpuInfo;
+  UINT32                 Index;
+
+  ZeroMem (&mPayloadPrefetch, sizeof (mPayloadPrefetch));
+  GetPayloadComponent (BootMode, &mPayloadPrefetch.ContainerSig, &mPayloadPrefetch.ComponentName);
+  Status = LocateComponent (mPayloadPrefetch.ContainerSig, mPayloadPrefetch.ComponentName,
+                            &mPayloadPrefetch.Source, &mPayloadPrefetch.Length);
+  if (EFI_ERROR (Status) || (mPayloadPrefetch.Length == 0)) {
+    return;
+  }
+
+  //
+  // Leave at least half of the free memory pool to the BSP. The buffer is
+  // temporary memory and is never freed on its own: later Stage2 temporary
+  // allocations stack on top of it, and all of it is released together when
+  // Stage2 hands over to the payload.
+  //
+  LdrGlobal = (LOADER_GLOBAL_DATA *)GetLoaderGlobalDataPointer();
+  if (mPayloadPrefetch.Length > (LdrGlobal->MemPoolCurrTop - LdrGlobal->MemPoolCurrBottom) / 2) {
+    return;
+  }
+
+  mPayloadPrefetch.Buffer = AllocateTemporaryMemory (mPayloadPrefetch.Length);
+  SysCpuInfo = MpGetInfo ();
+  for (Index = SysCpuInfo->CpuCount - 1; Index > 0; Index--) {
+    Status = MpRunTask (Index, PayloadPrefetchTask, (UINT64)(UINTN)&mPayloadPrefetch);
+    if (!EFI_ERROR (Status)) {
+      mPayloadPrefetch.CpuIndex = Index;
+      DEBUG ((DEBUG_INFO, "Prefetch payload 0x%X bytes on CPU%d\n", mPayloadPrefetch.Length, Index));
+      return;
+    }
+  }
+
+  // Nothing has been allocated since, so the buffer can be given back
+  FreeTemporaryMemory (mPayloadPrefetch.Buffer);
+  mPayloadPrefetch.Buffer = NULL;
+}
+
 /**
   Prepare and load payload into proper location for execution.
 
@@ -72,6 +188,7 @@ PreparePayload (
   UINT32                         ComponentName;
   UINT8                          BootMode;
   UINT64                         SignatureBuf;
+  volatile UINT8                *CpuState;
 
   BootMode = GetBootMode();
   //
@@ -82,18 +199,7 @@ PreparePayload (
   }
   // Load payload to PcdPayloadLoadBase.
   PayloadId   = GetPayloadId ();
-  if (BootMode == BOOT_ON_FLASH_UPDATE) {
-    ContainerSig  = COMP_TYPE_PAYLOAD_FWU;
-    ComponentName = FLASH_MAP_SIG_FWUPDATE;
-  } else {
-    if (PayloadId == 0) {
-      ContainerSig  = COMP_TYPE_PAYLOAD;
-      ComponentName = FLASH_MAP_SIG_PAYLOAD;
-    } else {
-      ContainerSig  = FLASH_MAP_SIG_EPAYLOAD;
-      ComponentName = PayloadId;
-    }
-  }
+  GetPayloadComponent (BootMode, &ContainerSig, &ComponentName);
   SignatureBuf = ComponentName;
   DEBUG ((DEBUG_INFO, "Loading Payload ID %4a\n", (CHAR8 *)&SignatureBuf));
 
@@ -106,10 +212,28 @@ PreparePayload (
   }
 
   AddMeasurePoint (0x3100);
-  DstLen = 0;
-  DstAdr = (VOID *)(UINTN)Dst;
-  Status = LoadComponentWithCallback (ContainerSig, ComponentName,
-                                      &DstAdr, &DstLen, LoadComponentCallback);
+  Status = EFI_NOT_STARTED;
+  if (mPayloadPrefetch.Buffer != NULL) {
+    CpuState = &MpGetTask ()->CpuTask[mPayloadPrefetch.CpuIndex].State;
+    while (*CpuState != EnumCpuReady) {
+      CpuPause ();
+    }
+    if ((mPayloadPrefetch.ContainerSig == ContainerSig) && (mPayloadPrefetch.ComponentName == ComponentName)) {
+      DstLen = 0;
+      DstAdr = (VOID *)(UINTN)Dst;
+      Status = LoadPrefetchedComponent (ContainerSig, ComponentName, mPayloadPrefetch.Source,
+                                        mPayloadPrefetch.Buffer, mPayloadPrefetch.Length,
+                                        &DstAdr, &DstLen, LoadComponentCallback);
+    }
+  }
+
+  if (EFI_ERROR (Status)) {
+    DstLen = 0;
+    DstAdr = (VOID *)(UINTN)Dst;
+    Status = LoadComponentWithCallback (ContainerSig, ComponentName,
+                                        &DstAdr, &DstLen, LoadComponentCallback);
+  }
+
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "Loading payload error - %r !", Status));
     return 0;
@@ -246,6 +370,11 @@ NormalBootPath (
     CallBoardNotify = TRUE;
   }
 
+  // Scrub the DMA buffer before it is handed over to the payload
+  if (LdrGlobal->DmaBufferPtr != NULL) {
+    MpZeroMem (LdrGlobal->DmaBufferPtr, PcdGet32 (PcdDmaBufferSize));
+  }
+
   if (FixedPcdGetBool (PcdSmpEnabled)) {
     // Only delay MpInitDone for OsLoader
     if ((PayloadId != 0) || (GetBootMode() == BOOT_ON_FLASH_UPDATE)) {
@@ -438,9 +567,9 @@ SecStartup (
   // Create base HOB
   BuildBaseInfoHob (Stage2Param);
 
-  // Display splash
+  // Display splash, the OS restores its own display on S3 resume
   SplashPostPci = FALSE;
-  if (FixedPcdGetBool (PcdSplashEnabled)) {
+  if (FixedPcdGetBool (PcdSplashEnabled) && (BootMode != BOOT_ON_S3_RESUME)) {
     Status = DisplaySplash ();
     AddMeasurePoint (0x3050);
     if (Status == EFI_NOT_FOUND) {
@@ -472,6 +601,9 @@ SecStartup (
   if (FixedPcdGetBool (PcdSmpEnabled) && !EFI_ERROR (Status)) {
     Status = MpInit (EnumMpInitRun);
     AddMeasurePoint (0x3080);
+    if (!EFI_ERROR (Status) && (BootMode != BOOT_ON_S3_RESUME)) {
+      StartPayloadPrefetch (BootMode);
+    }
   }
   ASSERT_EFI_ERROR (Status);
 
@@ -538,9 +670,10 @@ SecStartup (
   }
 
   //
-  // Allocate SMBIOS tables' memory, set Base and call Smbios init
+  // Allocate SMBIOS tables' memory, set Base and call Smbios init.
+  // The tables built on the normal boot are still in place on S3 resume.
   //
-  if (FixedPcdGetBool (PcdSmbiosEnabled)) {
+  if (FixedPcdGetBool (PcdSmbiosEnabled) && (BootMode != BOOT_ON_S3_RESUME)) {
     SmbiosEntry = AllocateZeroPool (PcdGet16(PcdSmbiosTablesSize));
     Status = PcdSet32S (PcdSmbiosTablesBase, (UINT32)(UINTN)SmbiosEntry);
     Status = SmbiosInit ();
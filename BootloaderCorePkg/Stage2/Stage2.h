@@ -63,6 +63,15 @@
 
 #define UIMAGE_FIT_MAGIC               (0x56190527)
 
+typedef struct {
+  UINT32                      ContainerSig;
+  UINT32                      ComponentName;
+  VOID                       *Source;
+  VOID                       *Buffer;
+  UINT32                      Length;
+  UINT32                      CpuIndex;
+} PAYLOAD_PREFETCH;
+
 /**
   Build some basic HOBs
 
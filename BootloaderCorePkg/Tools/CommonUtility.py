@@ -250,13 +250,76 @@ def adjust_hash_type (pub_key_file):
 
     return hash_type
 
+# Build cache for expensive post-build steps. It is enabled by setting
+# SBL_BUILD_CACHE to a directory. Entries are keyed by the content of all
+# inputs, including the tool binary, so they never need to be invalidated.
+_tool_hash = {}
+
+def get_build_cache_dir ():
+    cache_dir = os.environ.get('SBL_BUILD_CACHE', '')
+    if cache_dir:
+        os.makedirs (cache_dir, exist_ok = True)
+    return cache_dir
+
+def get_tool_hash (tool):
+    # identify a tool by its binary so that a rebuilt tool misses the cache
+    if tool not in _tool_hash:
+        path = shutil.which (tool)
+        # BaseTools wrapper scripts exec the real binary, hash that one instead
+        real = os.path.join (os.environ.get('EDK_TOOLS_PATH', ''), 'Source', 'C', 'bin', os.path.basename (tool))
+        if os.environ.get('EDK_TOOLS_PATH') and os.path.isfile (real):
+            path = real
+        if path and os.path.isfile (path):
+            _tool_hash[tool] = hashlib.sha256(get_file_data (path)).hexdigest()
+        else:
+            _tool_hash[tool] = 'missing:' + os.path.basename (tool)
+    return _tool_hash[tool]
+
+def get_cache_key (*items):
+    key = hashlib.sha256()
+    for item in items:
+        if isinstance (item, str):
+            item = item.encode()
+        key.update (hashlib.sha256(item).digest())
+    return key.hexdigest()
+
+def get_cached_data (key):
+    cache_dir = get_build_cache_dir ()
+    if not cache_dir:
+        return None
+    cache_file = os.path.join (cache_dir, key[:2], key)
+    if not os.path.isfile (cache_file):
+        return None
+    return get_file_data (cache_file)
+
+def put_cached_data (key, data):
+    cache_dir = get_build_cache_dir ()
+    if not cache_dir:
+        return
+    cache_file = os.path.join (cache_dir, key[:2], key)
+    os.makedirs (os.path.dirname (cache_file), exist_ok = True)
+    # write to a private file first so that concurrent builds never see a partial entry
+    tmp_file = '%s.%d.%d' % (cache_file, os.getpid(), id(data))
+    gen_file_from_object (tmp_file, data)
+    os.replace (tmp_file, cache_file)
+
 def rsa_sign_file (priv_key, pub_key, hash_type, sign_scheme, in_file, out_file, inc_dat = False, inc_key = False):
 
     bins = bytearray()
     if inc_dat:
         bins.extend(get_file_data(in_file))
 
-    single_sign_file(priv_key, hash_type, sign_scheme, in_file, out_file)
+    cache_key = None
+    if get_build_cache_dir ():
+        key_file  = get_key_from_store (priv_key)
+        cache_key = get_cache_key ('sign', hash_type, sign_scheme, get_file_data (key_file), get_file_data (in_file))
+    out_data = get_cached_data (cache_key) if cache_key else None
+    if out_data is not None:
+        gen_file_from_object (out_file, out_data)
+    else:
+        single_sign_file(priv_key, hash_type, sign_scheme, in_file, out_file)
+        if cache_key:
+            put_cached_data (cache_key, get_file_data (out_file))
 
     out_data = get_file_data(out_file)
 
@@ -410,7 +473,14 @@ def compress (in_file, alg, svn=0, out_path = '', tool_dir = ''):
     in_len = os.path.getsize(in_file)
     if in_len > 0:
         compress_tool = "%sCompress" % alg
-        if sig == "LZDM":
+        cache_key     = None
+        cached_data   = None
+        if sig != "LZDM" and get_build_cache_dir ():
+            cache_key = get_cache_key ('compress', sig, get_tool_hash (os.path.join (tool_dir, compress_tool)), get_file_data (in_file))
+            cached_data = get_cached_data (cache_key)
+        if cached_data is not None:
+            compress_data = cached_data
+        elif sig == "LZDM":
             shutil.copy(in_file, out_file)
             compress_data = get_file_data(out_file)
         elif sig == "LZ4 ":
@@ -440,6 +510,8 @@ def compress (in_file, alg, svn=0, out_path = '', tool_dir = ''):
                 in_file]
             run_process (cmdline, False, True)
             compress_data = get_file_data(out_file)
+        if cache_key and cached_data is None:
+            put_cached_data (cache_key, compress_data)
     else:
         compress_data = bytearray()
 
@@ -11,9 +11,18 @@ import argparse
 import re
 sys.dont_write_bytecode = True
 from   ctypes import *
+from   concurrent.futures import ThreadPoolExecutor
 from   CommonUtility import *
 
 
+def process_component (in_file, compress_alg, auth_type, key_file, svn, out_dir, tool_dir):
+    # compress a component file and calculate its auth info
+    lz_file = compress (in_file, compress_alg, svn, out_dir, tool_dir)
+    data    = bytearray(get_file_data (lz_file))
+    hash_data, auth_data = CONTAINER.calculate_auth_data (lz_file, auth_type, key_file, out_dir)
+    return data, hash_data, auth_data
+
+
 
 class COMPONENT_ENTRY (Structure):
     _pack_ = 1
@@ -445,6 +454,7 @@ class CONTAINER ():
 
         name_set = set()
         is_last_entry = False
+        comp_jobs = []
         for name, file, compress_alg, auth_type, key_file, alignment, region_size, svn in layout[1:]:
             if is_last_entry:
                 raise Exception ("'%s' must be the last entry in layout for monolithic signing!" % mono_sig)
@@ -481,12 +491,23 @@ class CONTAINER ():
                     compress_alg        = 'Dummy'
                     is_last_entry       = True
 
-            # compress the component
-            lz_file = compress (in_file, compress_alg, svn, self.out_dir, self.tool_dir)
-            component.data = bytearray(get_file_data (lz_file))
+            comp_jobs.append ((component, in_file, compress_alg, auth_type, key_file, region_size, svn))
 
-            # calculate the component auth info
-            component.hash_data, component.auth_data = CONTAINER.calculate_auth_data (lz_file, auth_type, key_file, self.out_dir)
+        # compress and sign the components, the results are consumed in layout order
+        comp_files = set ([os.path.splitext(os.path.basename(job[1]))[0] for job in comp_jobs])
+        if len(comp_files) == len(comp_jobs) and len(comp_jobs) > 1:
+            # intermediate files are named after the input file, so only run
+            # in parallel when they can not collide
+            workers = min (len(comp_jobs), os.cpu_count() or 1)
+        else:
+            workers = 1
+        with ThreadPoolExecutor (max_workers = workers) as executor:
+            results = list (executor.map (lambda job: process_component (job[1], job[2], job[3], job[4], job[6], self.out_dir, self.tool_dir), comp_jobs))
+
+        for (component, in_file, compress_alg, auth_type, key_file, region_size, svn), (data, hash_data, auth_data) in zip (comp_jobs, results):
+            component.data      = data
+            component.hash_data = hash_data
+            component.auth_data = auth_data
             component.hash_size = len(component.hash_data)
             if region_size == 0:
                 # arrange the region size automatically
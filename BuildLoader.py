@@ -176,6 +176,7 @@ class BaseBoard(object):
         self.ENABLE_EMMC_HS400     = 1
         self.ENABLE_DMA_PROTECTION = 0
         self.ENABLE_MULTI_USB_BOOT_DEV = 0
+        self.ENABLE_SPI_MMIO_READ  = 1
         self.ENABLE_SBL_SETUP      = 0
         self.ENABLE_PAYLOD_MODULE  = 0
         self.ENABLE_FAST_BOOT      = 0
@@ -1348,6 +1349,10 @@ def main():
     if 'WORKSPACE' not in os.environ:
         os.environ['WORKSPACE'] = os.environ['SBL_SOURCE']
 
+    # Reuse compression and signing results across builds, set SBL_BUILD_CACHE to '' to disable
+    if 'SBL_BUILD_CACHE' not in os.environ:
+        os.environ['SBL_BUILD_CACHE'] = os.path.join(os.environ['WORKSPACE'], 'Build', 'BuildCache')
+
     board_cfgs   = []
     board_names  = []
     module_names = []
@@ -19,11 +19,15 @@
 #include <Library/DecompressLib.h>
 #include <Library/ConfigDataLib.h>
 #include <Library/LiteFvLib.h>
+#include <Library/CryptoLib.h>
 #include "FirmwareUpdateHelper.h"
 #include <Service/SpiFlashService.h>
 
 SPI_FLASH_SERVICE   *mFwuSpiService = NULL;
 
+STATIC FW_UPDATE_JOURNAL_ENTRY  *mFwuJournal      = NULL;
+STATIC UINT32                   mFwuJournalCount  = 0;
+
 /**
   This function initialized boot media.
 
@@ -256,11 +260,47 @@ GetVersionfromFv (
   return EFI_SUCCESS;
 }
 
+/**
+  Check if a flash block has to be erased before it can be programmed.
+
+  SPI flash programming can only change bits from 1 to 0. If the new data
+  only clears bits of the current content, the block can be programmed
+  directly without erasing it first.
+
+  @param[in] Current          The current content of the block.
+  @param[in] New              The new content of the block.
+  @param[in] Length           The length of the block.
+
+  @retval  TRUE               The block needs to be erased.
+  @retval  FALSE              The block can be programmed directly.
+**/
+STATIC
+BOOLEAN
+IsBlockEraseRequired (
+  IN  UINT8     *Current,
+  IN  UINT8     *New,
+  IN  UINT32    Length
+  )
+{
+  UINT32        Index;
+
+  for (Index = 0; Index < Length; Index++) {
+    if ((Current[Index] & New[Index]) != New[Index]) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
 /**
   Update a region block.
 
-  This is the acture function to update boot meia. It will erase boot device,
-  write new data to boot device, and verify the written data.
+  This is the acture function to update boot meia. The current content of the
+  whole block is read once and compared against the new data in 4KB sectors.
+  Contiguous sectors that need erasing are erased together so that the SPI
+  controller can use 64KB erase where aligned. Sectors that only clear bits are
+  programmed without erase, and only the changed bytes are written and verified.
 
   @param[in] Address          The boot media address to be update.
   @param[in] Buffer           The source buffer to write to the boot media.
@@ -279,61 +319,85 @@ UpdateRegionBlock (
 {
   EFI_STATUS    Status;
   UINT8         *ReadBuffer;
+  UINT32        Pages;
   UINT32        Count;
   UINT32        BlockLen;
+  UINT32        EraseStart;
+  UINT32        EraseLen;
+  UINT32        Start;
+  UINT32        End;
   UINT8         *Src;
 
-  ReadBuffer = NULL;
-
   if (Length == 0) {
     return EFI_SUCCESS;
   }
 
-  ReadBuffer = AllocatePages (EFI_SIZE_TO_PAGES (SIZE_4KB));
+  Pages      = EFI_SIZE_TO_PAGES (ALIGN_VALUE (Length, SIZE_4KB));
+  ReadBuffer = AllocatePages (Pages);
   if (ReadBuffer == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
 
-  BlockLen   = SIZE_4KB;
   Src = (UINT8 *)Buffer;
 
   //
-  // Read, compare, erase, write, read, compare
+  // Read the current content of the whole block once
   //
-  for (Count = 0; Count < Length; Count += BlockLen) {
-    //
-    // If updating region less than 4K bytes,
-    // adjust the block length to size remaining, i.e less than 4k
-    //
-    if (Count + BlockLen > Length) {
-      BlockLen = Length - Count;
+  Status = BootMediaRead (Address, Length, ReadBuffer);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "BootMediaRead.  readaddr: 0x%llx, Status = 0x%x\n", Address, Status));
+    goto End;
+  }
+
+  //
+  // Erase pass: coalesce contiguous sectors that need erasing into one request.
+  // Block length for erase is always multiple of 4K bytes.
+  //
+  EraseStart = 0;
+  EraseLen   = 0;
+  for (Count = 0; ; Count += SIZE_4KB) {
+    if (Count < Length) {
+      BlockLen = MIN (SIZE_4KB, Length - Count);
+      if (IsBlockEraseRequired (ReadBuffer + Count, Src + Count, BlockLen)) {
+        if (EraseLen == 0) {
+          EraseStart = Count;
+        }
+        EraseLen += SIZE_4KB;
+        DEBUG ((DEBUG_INIT, "x"));
+        continue;
+      }
+      DEBUG ((DEBUG_INIT, (CompareMem (ReadBuffer + Count, Src + Count, BlockLen) == 0) ? "." : "+"));
     }
-    Status = BootMediaRead(Address + Count, BlockLen, ReadBuffer);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "BootMediaRead.  readaddr: 0x%llx, Status = 0x%x\n", Address + Count, Status));
-      goto End;
+
+    if (EraseLen > 0) {
+      Status = BootMediaErase ((UINT32) (Address + EraseStart), EraseLen);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "ERROR: in BootMediaErase. Status = 0x%x\n", Status));
+        goto End;
+      }
+      SetMem (ReadBuffer + EraseStart, MIN (EraseLen, Length - EraseStart), 0xFF);
+      EraseLen = 0;
     }
 
-    if (CompareMem (Src + Count, ReadBuffer, BlockLen) == 0) {
-      DEBUG ((DEBUG_INIT, "."));
-      continue;
+    if (Count >= Length) {
+      break;
     }
+  }
 
-    //
-    // Erase the boot media
-    // Block length for erase is always 4K bytes
-    //
-    DEBUG ((DEBUG_INIT, "x"));
-    Status = BootMediaErase ((UINT32) (Address + Count),  SIZE_4KB);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "ERROR: in BootMediaErase. Status = 0x%x\n", Status));
-      goto End;
+  //
+  // Program pass: write and verify only the changed bytes in each sector
+  //
+  for (Count = 0; Count < Length; Count += SIZE_4KB) {
+    BlockLen = MIN (SIZE_4KB, Length - Count);
+    for (Start = Count; (Start < Count + BlockLen) && (ReadBuffer[Start] == Src[Start]); Start++) {
+    }
+    if (Start == Count + BlockLen) {
+      continue;
+    }
+    for (End = Count + BlockLen; ReadBuffer[End - 1] == Src[End - 1]; End--) {
     }
 
-    //
-    // Write to the boot media
-    //
-    Status = BootMediaWrite ((UINT32) (Address + Count),  BlockLen, Src + Count);
+    Status = BootMediaWrite ((UINT32) (Address + Start), End - Start, Src + Start);
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_ERROR, "ERROR: in BootDeviceWrite. Status = 0x%x\n", Status));
       goto End;
@@ -342,8 +406,8 @@ UpdateRegionBlock (
     //
     // Verify the written data
     //
-    Status = BootMediaRead (Address + Count, BlockLen, ReadBuffer);
-    if (CompareMem (Src + Count, ReadBuffer, BlockLen) != 0) {
+    Status = BootMediaRead (Address + Start, End - Start, ReadBuffer + Start);
+    if (EFI_ERROR (Status) || (CompareMem (Src + Start, ReadBuffer + Start, End - Start) != 0)) {
       DEBUG ((DEBUG_ERROR, "Verify Error !\n"));
       Status = EFI_DEVICE_ERROR;
       goto End;
@@ -351,17 +415,150 @@ UpdateRegionBlock (
   }
 
 End:
-  if (ReadBuffer != NULL) {
-    FreePages (ReadBuffer, EFI_SIZE_TO_PAGES (SIZE_4KB));
-  }
+  FreePages (ReadBuffer, Pages);
 
   return Status;
 }
 
+/**
+  Load the firmware update journal from the reserved region.
+
+  The journal is cached in memory so that looking up a block does not
+  require any boot media access. If the journal cannot be read, blocks
+  are simply updated without it.
+
+**/
+STATIC
+VOID
+LoadUpdateJournal (
+  VOID
+  )
+{
+  EFI_STATUS    Status;
+  UINT32        MaxCount;
+  UINT32        Index;
+  UINT8         *Entry;
+
+  mFwuJournalCount = 0;
+  if (mFwuJournal == NULL) {
+    mFwuJournal = (FW_UPDATE_JOURNAL_ENTRY *) AllocatePool (FW_UPDATE_JOURNAL_SIZE);
+    if (mFwuJournal == NULL) {
+      return;
+    }
+  }
+
+  Status = BootMediaRead (PcdGet32 (PcdFwUpdStatusBase) + FW_UPDATE_JOURNAL_OFFSET,
+                          FW_UPDATE_JOURNAL_SIZE, (UINT8 *)mFwuJournal);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "Failed to read update journal, Status = %r\n", Status));
+    FreePool (mFwuJournal);
+    mFwuJournal = NULL;
+    return;
+  }
+
+  //
+  // The journal ends at the first entry that is still fully erased
+  //
+  MaxCount = FW_UPDATE_JOURNAL_SIZE / sizeof (FW_UPDATE_JOURNAL_ENTRY);
+  for (; mFwuJournalCount < MaxCount; mFwuJournalCount++) {
+    Entry = (UINT8 *)&mFwuJournal[mFwuJournalCount];
+    for (Index = 0; Index < sizeof (FW_UPDATE_JOURNAL_ENTRY); Index++) {
+      if (Entry[Index] != FW_UPDATE_JOURNAL_FREE) {
+        break;
+      }
+    }
+    if (Index == sizeof (FW_UPDATE_JOURNAL_ENTRY)) {
+      break;
+    }
+  }
+
+  if (mFwuJournalCount > 0) {
+    DEBUG ((DEBUG_INFO, "Update journal has %d completed blocks\n", mFwuJournalCount));
+  }
+}
+
+/**
+  Check if a block has already been updated and verified.
+
+  The latest journal entry for the address wins, so a block written
+  more than once within the same update is handled correctly.
+
+  @param[in] Address          The boot media address of the block.
+  @param[in] Hash             The SHA-256 hash of the new block data.
+
+  @retval  TRUE               The block already contains the new data.
+  @retval  FALSE              The block needs to be updated.
+**/
+STATIC
+BOOLEAN
+IsBlockJournaled (
+  IN  UINT32    Address,
+  IN  UINT8     *Hash
+  )
+{
+  UINT32        Index;
+
+  if (mFwuJournal == NULL) {
+    return FALSE;
+  }
+
+  for (Index = mFwuJournalCount; Index > 0; Index--) {
+    if (mFwuJournal[Index - 1].Address == Address) {
+      return (BOOLEAN)(CompareMem (mFwuJournal[Index - 1].Hash, Hash, SHA256_DIGEST_SIZE) == 0);
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Record a verified block in the firmware update journal.
+
+  Entries are only appended into erased space, so no erase is needed and
+  a power loss can at most leave a partial entry that will not match.
+  Once the journal is full, further blocks are no longer recorded.
+
+  @param[in] Address          The boot media address of the block.
+  @param[in] Hash             The SHA-256 hash of the block data.
+
+**/
+STATIC
+VOID
+AddJournalEntry (
+  IN  UINT32    Address,
+  IN  UINT8     *Hash
+  )
+{
+  EFI_STATUS    Status;
+  UINT32        Offset;
+
+  if ((mFwuJournal == NULL) ||
+      (mFwuJournalCount >= FW_UPDATE_JOURNAL_SIZE / sizeof (FW_UPDATE_JOURNAL_ENTRY))) {
+    return;
+  }
+
+  mFwuJournal[mFwuJournalCount].Address = Address;
+  CopyMem (mFwuJournal[mFwuJournalCount].Hash, Hash, SHA256_DIGEST_SIZE);
+
+  Offset = PcdGet32 (PcdFwUpdStatusBase) + FW_UPDATE_JOURNAL_OFFSET +
+           mFwuJournalCount * sizeof (FW_UPDATE_JOURNAL_ENTRY);
+  Status = BootMediaWrite (Offset, sizeof (FW_UPDATE_JOURNAL_ENTRY), (UINT8 *)&mFwuJournal[mFwuJournalCount]);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "Failed to write update journal, Status = %r\n", Status));
+  }
+
+  //
+  // Consume the slot even on failure since it may be partially programmed
+  //
+  mFwuJournalCount++;
+}
+
 /**
   Update a boot region.
 
-  This function also output the update process info.
+  This function also output the update process info. Blocks that the
+  update journal shows as already written with the same data are skipped,
+  and every other block is recorded in the journal once it is verified.
 
   @param[in] UpdateRegion     The detail information for this region to update.
   @param[in] WrittenSize      The data size has been written before this region.
@@ -382,6 +579,7 @@ UpdateBootRegion (
   UINT32        UpdatedSize;
   UINT64        UpdateAddress;
   UINT8         *Buffer;
+  UINT8         Hash[SHA256_DIGEST_SIZE];
 
   //
   // Here write 64KB every time in order to show update process.
@@ -400,11 +598,17 @@ UpdateBootRegion (
         UpdateBlockSize = SIZE_64KB;
       }
     }
-    DEBUG ((DEBUG_INIT, "Updating 0x%08llx, Size:0x%05x\n", UpdateAddress, UpdateBlockSize));
-    Status = UpdateRegionBlock (UpdateAddress, Buffer, UpdateBlockSize);
-    if (EFI_ERROR (Status)) {
-      DEBUG ((DEBUG_ERROR, "\nFailed! Address=0x%08llx, Status = %r\n", UpdateAddress, Status));
-      return Status;
+    Sha256 (Buffer, UpdateBlockSize, Hash);
+    if (IsBlockJournaled ((UINT32)UpdateAddress, Hash)) {
+      DEBUG ((DEBUG_INIT, "Skipping 0x%08llx, Size:0x%05x (journaled)", UpdateAddress, UpdateBlockSize));
+    } else {
+      DEBUG ((DEBUG_INIT, "Updating 0x%08llx, Size:0x%05x\n", UpdateAddress, UpdateBlockSize));
+      Status = UpdateRegionBlock (UpdateAddress, Buffer, UpdateBlockSize);
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "\nFailed! Address=0x%08llx, Status = %r\n", UpdateAddress, Status));
+        return Status;
+      }
+      AddJournalEntry ((UINT32)UpdateAddress, Hash);
     }
     UpdateAddress += UpdateBlockSize;
     Buffer        += UpdateBlockSize;
@@ -440,6 +644,8 @@ UpdateBootPartition (
     return Status;
   }
 
+  LoadUpdateJournal ();
+
   TotalUpdateSize = 0;
   for (Index = 0; Index < UpdatePartition->RegionCount; Index++) {
     UpdateRegion     = &UpdatePartition->FwRegion[Index];
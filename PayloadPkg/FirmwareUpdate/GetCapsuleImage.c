@@ -183,6 +183,12 @@ GetCapsuleFromRawPartition (
   AlginedImageSize = ((ImageSize % BlockSize) == 0) ? \
                      ImageSize : \
                      ((ImageSize / BlockSize) + 1) * BlockSize;
+  if ((ImageSize == 0) || (AlginedImageSize < AlginedHeaderSize) ||
+      (DivU64x32 (AlginedImageSize, BlockSize) > \
+       LogicBlkDev.LastBlock - LogicBlkDev.StartBlock - CapsuleInfo->LbaAddr + 1)) {
+    DEBUG ((DEBUG_INFO, "Invalid Capsule image found, Image size 0x%x out of range\n", ImageSize));
+    return EFI_LOAD_ERROR;
+  }
 
   Buffer = (UINT8 *) AllocatePages (EFI_SIZE_TO_PAGES (AlginedImageSize));
   if (Buffer == NULL) {
@@ -191,21 +197,22 @@ GetCapsuleFromRawPartition (
   }
 
   //
-  // Read the capsule image into the buffer
+  // The header blocks were already read above, so only fetch the rest of the
+  // capsule image into the buffer
   //
-  Status = MediaReadBlocks (
-             CapsuleInfo->HwPart,
-             LogicBlkDev.StartBlock + CapsuleInfo->LbaAddr,
-             AlginedImageSize,
-             Buffer
-             );
-  if (EFI_ERROR (Status)) {
-    DEBUG ((DEBUG_INFO, "Read capsule image error, Status = %r\n", Status));
-    return  Status;
-  }
-
-  if ((Buffer == NULL) || (ImageSize == 0)) {
-    return EFI_LOAD_ERROR;
+  CopyMem (Buffer, BlockData, AlginedHeaderSize);
+  if (AlginedImageSize > AlginedHeaderSize) {
+    Status = MediaReadBlocks (
+               CapsuleInfo->HwPart,
+               LogicBlkDev.StartBlock + CapsuleInfo->LbaAddr + AlginedHeaderSize / BlockSize,
+               AlginedImageSize - AlginedHeaderSize,
+               (UINT8 *)Buffer + AlginedHeaderSize
+               );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_INFO, "Read capsule image error, Status = %r\n", Status));
+      FreePages (Buffer, EFI_SIZE_TO_PAGES (AlginedImageSize));
+      return  Status;
+    }
   }
 
   *CapsuleImage = Buffer;
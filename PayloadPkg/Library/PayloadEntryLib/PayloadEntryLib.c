@@ -10,7 +10,7 @@
 #include <Library/BaseLib.h>
 #include <Library/DebugLib.h>
 #include <Library/PcdLib.h>
-#include <Library/HobLib.h>
+#include <Library/BlHobLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/PayloadLib.h>
 #include <Library/BootloaderCommonLib.h>
@@ -119,6 +119,9 @@ PayloadInit (
   PcdStatus2 = PcdSet32S (PcdGlobalDataAddress, (UINT32) (UINTN)GlobalDataPtr);
   ASSERT_EFI_ERROR (PcdStatus1 | PcdStatus2);
 
+  // Index the HOB list so that later GUID HOB lookups don't walk the list
+  BuildHobIndex (HobList);
+
   // Create Debug Log Buffer and init configuration data
   GuidHob = GetNextGuidHob (&gLoaderPlatformDataGuid, (VOID *)(UINTN)PcdGet32 (PcdPayloadHobList));
   if (GuidHob != NULL) {
@@ -80,6 +80,8 @@ class Board(BaseBoard):
         self.ENABLE_FRAMEBUFFER_INIT  = 1
         self.ENABLE_GRUB_CONFIG       = 1
         self.ENABLE_DMA_PROTECTION    = 0
+        # BIOS region is not linearly decoded below 4GB
+        self.ENABLE_SPI_MMIO_READ     = 0
         self.ENABLE_SMM_REBASE        = 2
 
         # G9 for 384 | W7 Opt for SHA384| Ni  Opt for SHA256| V8 Opt for SHA256
@@ -17,6 +17,7 @@
 #include <Library/BootloaderCommonLib.h>
 #include <Library/PchSpiLib.h>
 #include <Guid/OsBootOptionGuid.h>
+#include <Guid/FlashMapInfoGuid.h>
 #include <Register/RegsSpi.h>
 
 //
@@ -32,6 +33,12 @@
 #define WAIT_TIME   6000000     ///< Wait Time = 6 seconds = 6000000 microseconds
 #define WAIT_PERIOD 10          ///< Wait Period = 10 microseconds
 
+//
+// Top of the BIOS region that is decoded below 4GB
+//
+#define BIOS_MMIO_WINDOW_SIZE  SIZE_16MB
+#define BIOS_MMIO_CACHE_LINE   64
+
 //
 // Flash cycle Type
 //
@@ -121,6 +128,113 @@ WaitForSpiCycleComplete (
   IN     BOOLEAN            ErrorCheck
   );
 
+/**
+  Get the memory mapped address of a flash range in the BIOS region.
+
+  The top of the BIOS region is decoded just below 4GB, so reads fully inside
+  this window can be served by a memory copy instead of hardware sequencing.
+  The top swap regions are excluded since their decode may be swapped.
+
+  @param[in] FlashRegionType      The Flash Region type for flash cycle which is listed in the Descriptor.
+  @param[in] Address              The Flash Linear Address relative to the region.
+  @param[in] ByteCount            Number of bytes in the range.
+
+  @retval    NULL                 The range is not fully memory mapped.
+  @retval    Others               The memory mapped address of the range.
+**/
+STATIC
+VOID *
+GetBiosMmioAddress (
+  IN     FLASH_REGION_TYPE  FlashRegionType,
+  IN     UINT32             Address,
+  IN     UINT32             ByteCount
+  )
+{
+  EFI_STATUS      Status;
+  FLASH_MAP      *FlashMap;
+  UINT32          BiosBase;
+  UINT32          BiosSize;
+  UINT32          WindowStart;
+  UINT32          WindowLimit;
+  UINT32          TopSwapSize;
+
+  if (!FeaturePcdGet (PcdSpiMmioReadEnabled)) {
+    return NULL;
+  }
+
+  if ((FlashRegionType != FlashRegionBios) && (FlashRegionType != FlashRegionAll)) {
+    return NULL;
+  }
+
+  FlashMap = GetFlashMapPtr ();
+  if (FlashMap == NULL) {
+    return NULL;
+  }
+
+  Status = SpiGetRegionAddress (FlashRegionBios, &BiosBase, &BiosSize);
+  if (EFI_ERROR (Status) || (BiosSize < FlashMap->RomSize)) {
+    return NULL;
+  }
+
+  if (FlashRegionType == FlashRegionAll) {
+    if (Address < BiosBase) {
+      return NULL;
+    }
+    Address -= BiosBase;
+  }
+
+  WindowStart = (BiosSize > BIOS_MMIO_WINDOW_SIZE) ? (BiosSize - BIOS_MMIO_WINDOW_SIZE) : 0;
+  WindowLimit = BiosSize;
+
+  //
+  // Both top swap partitions sit at the top of the ROM. Their mapping flips
+  // when top swap is set, so reads from either one must go through SPI.
+  //
+  TopSwapSize = GetRegionOffsetSize (FlashMap, FLASH_MAP_FLAGS_TOP_SWAP, NULL);
+  if (TopSwapSize != 0) {
+    if (2 * TopSwapSize > FlashMap->RomSize) {
+      return NULL;
+    }
+    WindowLimit = BiosSize - 2 * TopSwapSize;
+  }
+
+  if ((Address < WindowStart) || (Address >= WindowLimit) || (ByteCount > WindowLimit - Address)) {
+    return NULL;
+  }
+
+  return (VOID *)(UINTN)(0x100000000ULL - BiosSize + Address);
+}
+
+/**
+  Invalidate the CPU cache for a memory mapped flash range after it is changed.
+
+  @param[in] FlashRegionType      The Flash Region type for flash cycle which is listed in the Descriptor.
+  @param[in] Address              The Flash Linear Address relative to the region.
+  @param[in] ByteCount            Number of bytes in the range.
+**/
+STATIC
+VOID
+InvalidateBiosMmioRange (
+  IN     FLASH_REGION_TYPE  FlashRegionType,
+  IN     UINT32             Address,
+  IN     UINT32             ByteCount
+  )
+{
+  UINTN           Start;
+  UINTN           End;
+
+  Start = (UINTN)GetBiosMmioAddress (FlashRegionType, Address, ByteCount);
+  if ((Start == 0) || (ByteCount == 0)) {
+    return;
+  }
+
+  End   = Start + ByteCount;
+  Start = Start & ~((UINTN)BIOS_MMIO_CACHE_LINE - 1);
+  for (; Start < End; Start += BIOS_MMIO_CACHE_LINE) {
+    AsmFlushCacheLine ((VOID *)Start);
+  }
+}
+
 /**
   Get SPI Instance from library global data..
 
@@ -283,6 +397,16 @@ SpiFlashRead (
   )
 {
   EFI_STATUS        Status;
+  VOID             *MmioAddress;
+
+  ///
+  /// Copy directly from the memory mapped BIOS window when possible.
+  ///
+  MmioAddress = GetBiosMmioAddress (FlashRegionType, Address, ByteCount);
+  if ((MmioAddress != NULL) && (Buffer != NULL)) {
+    CopyMem (Buffer, MmioAddress, ByteCount);
+    return EFI_SUCCESS;
+  }
 
   ///
   /// Sends the command to the SPI interface to execute.
@@ -330,6 +454,7 @@ SpiFlashWrite (
              ByteCount,
              Buffer
              );
+  InvalidateBiosMmioRange (FlashRegionType, Address, ByteCount);
   return Status;
 }
 
@@ -364,6 +489,7 @@ SpiFlashErase (
              ByteCount,
              NULL
              );
+  InvalidateBiosMmioRange (FlashRegionType, Address, ByteCount);
   return Status;
 }
 
@@ -800,8 +926,11 @@ SendSpiCmd (
       }
     }
     if (FlashCycleType == FlashCycleErase) {
-      if (((ByteCount / SIZE_64KB) != 0) &&
-          ((ByteCount % SIZE_64KB) == 0) &&
+      ///
+      /// Use 64KB erase for every 64KB aligned chunk of the range if supported,
+      /// and fall back to 4KB erase for the unaligned head and tail.
+      ///
+      if ((ByteCount >= SIZE_64KB) &&
           ((HardwareSpiAddr % SIZE_64KB) == 0)) {
         if (HardwareSpiAddr < SpiInstance->Component1StartAddr) {
           //